@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+
+namespace zexjson{
+
+/**
+ * Makes a document of about the given size for the benchmarks to read.
+ *
+ * The root is an array of records shaped like a typical API payload:
+ * strings with and without escapes, integers, fractions, literals and a
+ * short nested array in each.
+*/
+inline std::string MakeBenchmarkDocument(const std::size_t TargetBytes)
+{
+    std::string Document = "[";
+    Document.reserve(TargetBytes + 512);
+
+    for(std::size_t Index = 0; Document.size() < TargetBytes; ++Index){
+        if(Index != 0){
+            Document += ',';
+        }
+
+        const std::string Id = std::to_string(Index);
+
+        Document += "\n  {\"id\": " + Id
+            + ", \"name\": \"user " + Id + "\""
+            + ", \"email\": \"user" + Id + "@example.com\""
+            + ", \"score\": " + std::to_string(Index % 1000) + ".25"
+            + ", \"active\": " + (Index % 3 ? "true" : "false")
+            + ", \"tags\": [\"alpha\", \"beta\", \"gamma\"]"
+            + ", \"bio\": \"Says \\\"hi\\\"\\nand caf\\u00e9 to everyone\""
+            + ", \"parent\": null}";
+    }
+
+    Document += "\n]";
+    return Document;
+}
+
+/**
+ * Runs Body the given number of times and prints the best throughput reached.
+ *
+ * @param Name Label of the case in the output.
+ * @param Bytes Size of the input one run reads.
+ * @param Body Reads the input once, returning @c false on failure.
+*/
+template<class BodyType>
+bool RunBenchmark(const char* const Name, const std::size_t Bytes, const int Runs, BodyType&& Body)
+{
+    double BestSeconds = 0.0;
+
+    for(int Run = 0; Run < Runs; ++Run){
+        const auto Start = std::chrono::steady_clock::now();
+
+        if(!Body()){
+            std::printf("%-32s failed\n", Name);
+            return false;
+        }
+
+        const std::chrono::duration<double> Elapsed = std::chrono::steady_clock::now() - Start;
+        if(Run == 0 || Elapsed.count() < BestSeconds){
+            BestSeconds = Elapsed.count();
+        }
+    }
+
+    std::printf("%-32s %9.1f MB/s %9.3f s\n", Name, Bytes / BestSeconds / (1024.0 * 1024.0), BestSeconds);
+    return true;
+}
+
+} // namespace zexjson
@@ -0,0 +1,139 @@
+#include "BenchmarkUtils.hpp"
+
+#include "Serialization/JsonSerializer.hpp"
+
+#include <cstdlib>
+
+using namespace zexjson;
+
+namespace{
+
+/**
+ * The recursive builder consumers wrote before JsonSerializer::Deserialize(),
+ * copying names and strings out of the reader unless bUseViews is set, in
+ * which case they are made straight from its views.
+*/
+template<bool bUseViews>
+struct HandRolledBuilder
+{
+    static std::shared_ptr<JsonValue> BuildValue(JsonReader<char>& Reader, const EJsonNotation Notation)
+    {
+        switch (Notation)
+        {
+        case EJsonNotation::ObjectStart:
+        {
+            std::shared_ptr<JsonObject> Object = BuildObject(Reader);
+            return Object ? std::make_shared<JsonValueObject>(std::move(Object)) : nullptr;
+        }
+
+        case EJsonNotation::ArrayStart:
+        {
+            JsonArray Array;
+            EJsonNotation Next;
+
+            while(Reader.ReadNext(Next) && Next != EJsonNotation::ArrayEnd){
+                std::shared_ptr<JsonValue> Element = BuildValue(Reader, Next);
+                if(!Element){
+                    return nullptr;
+                }
+
+                Array.push_back(std::move(Element));
+            }
+
+            return Next == EJsonNotation::ArrayEnd ? std::make_shared<JsonValueArray>(std::move(Array)) : nullptr;
+        }
+
+        case EJsonNotation::String:
+            if constexpr (bUseViews){
+                return std::make_shared<JsonValueString>(Reader.GetValueAsStringView());
+            }else{
+                return std::make_shared<JsonValueString>(Reader.GetValueAsString());
+            }
+
+        case EJsonNotation::Number:
+            return std::make_shared<JsonValueNumber>(Reader.GetValueAsNumber());
+
+        case EJsonNotation::Boolean:
+            return std::make_shared<JsonValueBoolean>(Reader.GetValueAsBoolean());
+
+        case EJsonNotation::Null:
+            return std::make_shared<JsonValueNull>();
+
+        default:
+            return nullptr;
+        }
+    }
+
+    static std::shared_ptr<JsonObject> BuildObject(JsonReader<char>& Reader)
+    {
+        std::shared_ptr<JsonObject> Object = std::make_shared<JsonObject>();
+        EJsonNotation Next;
+
+        while(Reader.ReadNext(Next) && Next != EJsonNotation::ObjectEnd){
+            // Reading a nested container replaces the identifier, so take it first
+            JsonName Name;
+            if constexpr (bUseViews){
+                Name = JsonName(Reader.GetIdentifierView());
+            }else{
+                Name = JsonName(Reader.GetIdentifier());
+            }
+
+            std::shared_ptr<JsonValue> Value = BuildValue(Reader, Next);
+            if(!Value){
+                return nullptr;
+            }
+
+            Object->Values.insert_or_assign(std::move(Name), std::move(Value));
+        }
+
+        return Next == EJsonNotation::ObjectEnd ? Object : nullptr;
+    }
+
+    static bool Build(const std::string& Document)
+    {
+        const auto Reader = JsonStringViewReader::Create(Document);
+        EJsonNotation Notation;
+
+        return Reader->ReadNext(Notation) && BuildValue(*Reader, Notation) != nullptr;
+    }
+};
+
+} // namespace
+
+/**
+ * Compares JsonSerializer::Deserialize() with hand-rolled recursive builders.
+ *
+ * Every case reads the same document through JsonStringViewReader, so the
+ * differences come from building the tree.
+ * Usage: BuilderBenchmark [size in MiB, default 64] [runs, default 3]
+*/
+int main(int argc, char** argv)
+{
+    const std::size_t MegaBytes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+    const int Runs = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    const std::string Document = MakeBenchmarkDocument(MegaBytes * 1024 * 1024);
+    std::printf("Document: %zu bytes, best of %d runs\n", Document.size(), Runs);
+
+    bool bSuccess = true;
+
+    bSuccess &= RunBenchmark("hand-rolled, copying", Document.size(), Runs, [&]() { return HandRolledBuilder<false>::Build(Document); });
+    bSuccess &= RunBenchmark("hand-rolled, views", Document.size(), Runs, [&]() { return HandRolledBuilder<true>::Build(Document); });
+
+    bSuccess &= RunBenchmark("Deserialize, JsonValue", Document.size(), Runs, [&]() {
+        std::shared_ptr<JsonValue> Root;
+        return JsonSerializer::Deserialize(JsonStringViewReader::Create(Document), Root);
+    });
+
+    bSuccess &= RunBenchmark("Deserialize, JsonDocument", Document.size(), Runs, [&]() {
+        const std::shared_ptr<JsonDocument> Root = JsonDocument::Create();
+        return JsonSerializer::Deserialize(JsonStringViewReader::Create(Document), *Root);
+    });
+
+    bSuccess &= RunBenchmark("Deserialize, JsonCompactValue", Document.size(), Runs, [&]() {
+        JsonCompactValue Root;
+        return JsonSerializer::Deserialize(JsonStringViewReader::Create(Document), Root);
+    });
+
+    return bSuccess ? 0 : 1;
+}
@@ -0,0 +1,64 @@
+#include "BenchmarkUtils.hpp"
+
+#include "Serialization/JsonReader.hpp"
+
+#include <cstdlib>
+#include <sstream>
+
+using namespace zexjson;
+
+namespace{
+
+/** Reads every notation of the document, returning @c false on a syntax error */
+template<class CharType>
+bool ReadAll(JsonReader<CharType>& Reader)
+{
+    EJsonNotation Notation;
+    std::size_t Count = 0;
+
+    while(Reader.ReadNext(Notation)){
+        ++Count;
+    }
+
+    return Count != 0 && Reader.GetErrorMessage().empty();
+}
+
+/** Reads the document from an istream, asking it for BlockSize bytes per refill */
+bool ReadFromStream(const std::string& Document, const std::size_t BlockSize)
+{
+    std::istringstream Stream(Document);
+    const auto Reader = JsonReader<char>::Create(std::make_unique<JsonStreamInputSource<char>>(&Stream, BlockSize));
+    return ReadAll(*Reader);
+}
+
+} // namespace
+
+/**
+ * Compares the throughput of JsonReader over its input sources.
+ *
+ * A block size of one byte makes one istream::read() call per character,
+ * the way the reader read before it pulled its input in blocks.
+ * Usage: ReaderBenchmark [size in MiB, default 64] [runs, default 3]
+*/
+int main(int argc, char** argv)
+{
+    const std::size_t MegaBytes = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+    const int Runs = argc > 2 ? std::atoi(argv[2]) : 3;
+
+    const std::string Document = MakeBenchmarkDocument(MegaBytes * 1024 * 1024);
+    std::printf("Document: %zu bytes, best of %d runs\n", Document.size(), Runs);
+
+    bool bSuccess = true;
+
+    bSuccess &= RunBenchmark("istream, 1 B blocks", Document.size(), Runs, [&]() { return ReadFromStream(Document, 1); });
+    bSuccess &= RunBenchmark("istream, 4 KiB blocks", Document.size(), Runs, [&]() { return ReadFromStream(Document, 4 * 1024); });
+    bSuccess &= RunBenchmark("istream, 64 KiB blocks", Document.size(), Runs, [&]() { return ReadFromStream(Document, JsonStreamInputSource<char>::DefaultBlockSize); });
+    bSuccess &= RunBenchmark("istream, 1 MiB blocks", Document.size(), Runs, [&]() { return ReadFromStream(Document, 1024 * 1024); });
+
+    bSuccess &= RunBenchmark("JsonStringViewReader", Document.size(), Runs, [&]() {
+        const auto Reader = JsonStringViewReader::Create(Document);
+        return ReadAll(*Reader);
+    });
+
+    return bSuccess ? 0 : 1;
+}
@@ -0,0 +1,417 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "Serialization/JsonTypes.hpp"
+
+#include <cstring>
+
+namespace zexjson{
+
+/**
+ * A Json value packed into 16 bytes, without virtual dispatch.
+ *
+ * Numbers, booleans and strings of up to InlineCapacity characters are stored
+ * in place. Longer strings, arrays and objects own a single heap block. Arrays
+ * hold their elements by value in contiguous storage and objects keep their
+ * fields in insertion order, so walking either touches memory linearly.
+ *
+ * Exposes the same accessor surface as JsonValue (AsNumber, AsString,
+ * TryGetNumber, ...); the type checks are plain switches on the tag and
+ * inline into the caller.
+*/
+class JsonCompactValue
+{
+public:
+    using ArrayType = std::vector<JsonCompactValue>;
+    using ObjectType = std::vector<std::pair<std::string, JsonCompactValue>>;
+
+    /** Longest string that is stored without a heap allocation */
+    static constexpr std::size_t InlineCapacity = 14;
+
+    JsonCompactValue() : Storage{}, Kind(EKind::None) {}
+    JsonCompactValue(std::nullptr_t) : Storage{}, Kind(EKind::Null) {}
+    JsonCompactValue(bool InBool) : Storage{}, Kind(EKind::Boolean) { Store(InBool); }
+    JsonCompactValue(double InNumber) : Storage{}, Kind(EKind::Double) { Store(InNumber); }
+    JsonCompactValue(std::int32_t InNumber) : JsonCompactValue(static_cast<std::int64_t>(InNumber)) {}
+    JsonCompactValue(std::int64_t InNumber) : Storage{}, Kind(EKind::Int64) { Store(InNumber); }
+    JsonCompactValue(std::uint32_t InNumber) : JsonCompactValue(static_cast<std::int64_t>(InNumber)) {}
+    JsonCompactValue(std::uint64_t InNumber);
+
+    /** Stores any other integer exactly, e.g. JsonCompactValue(5LL) or JsonCompactValue(5ul) */
+    template<typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    JsonCompactValue(T InNumber) :
+        JsonCompactValue(ToStoredInteger(InNumber))
+        {}
+
+    /** Stores any other floating-point number as a double */
+    template<typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+    JsonCompactValue(T InNumber) :
+        JsonCompactValue(static_cast<double>(InNumber))
+        {}
+
+    JsonCompactValue(std::string_view InString);
+    JsonCompactValue(const char* InString) : JsonCompactValue(std::string_view(InString)) {}
+    JsonCompactValue(const std::string& InString) : JsonCompactValue(std::string_view(InString)) {}
+    JsonCompactValue(ArrayType&& InArray);
+    JsonCompactValue(ObjectType&& InObject);
+
+    JsonCompactValue(const JsonCompactValue& Other);
+    JsonCompactValue(JsonCompactValue&& Other) noexcept;
+    JsonCompactValue& operator=(const JsonCompactValue& Other);
+    JsonCompactValue& operator=(JsonCompactValue&& Other) noexcept;
+    ~JsonCompactValue() { if(Kind >= EKind::HeapString){ Release(); } }
+
+    /** Returns the Json type of this value */
+    inline EJson GetType() const
+    {
+        switch (Kind)
+        {
+        case EKind::Null:        return EJson::Null;
+        case EKind::Boolean:     return EJson::Boolean;
+        case EKind::Double:
+        case EKind::Int64:
+        case EKind::UInt64:      return EJson::Number;
+        case EKind::SmallString:
+        case EKind::HeapString:  return EJson::String;
+        case EKind::Array:       return EJson::Array;
+        case EKind::Object:      return EJson::Object;
+        default:                 return EJson::None;
+        }
+    }
+
+    /** Returns how a number is stored; only meaningful if this is a Json Number */
+    inline EJsonNumber GetNumberType() const
+    {
+        return Kind == EKind::Int64 ? EJsonNumber::Int64 : (Kind == EKind::UInt64 ? EJsonNumber::UInt64 : EJsonNumber::Double);
+    }
+
+    /** Returns true if this value is a 'null' */
+    inline bool IsNull() const { return Kind == EKind::Null || Kind == EKind::None; }
+
+    /** Returns this value as a double, returning zero if this is not an Json Number */
+    inline double AsNumber() const
+    {
+        double Number{0.0};
+        TryGetNumber(Number);
+        return Number;
+    }
+
+    /** Returns this value as a string, returning empty string if not possible */
+    inline std::string AsString() const
+    {
+        std::string String;
+        TryGetString(String);
+        return String;
+    }
+
+    /** Returns a view of the string, or an empty view if this is not a Json String */
+    inline std::string_view AsStringView() const
+    {
+        switch (Kind)
+        {
+        case EKind::SmallString:
+            return std::string_view(Storage, static_cast<std::uint8_t>(Storage[InlineCapacity]));
+
+        case EKind::HeapString:
+        {
+            const HeapString* String = Load<HeapString*>();
+            return std::string_view(String->Data, String->Length);
+        }
+
+        default:
+            return std::string_view();
+        }
+    }
+
+    /** Returns this value as a bool, returning false if not possible */
+    inline bool AsBool() const
+    {
+        bool Bool{false};
+        TryGetBool(Bool);
+        return Bool;
+    }
+
+    /** Returns this value as an array, returning an empty array reference if not possible */
+    const ArrayType& AsArray() const;
+
+    /** Returns this value as an object, returning an empty object reference if not possible */
+    const ObjectType& AsObject() const;
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    inline bool TryGetNumber(double& OutNumber) const
+    {
+        switch (Kind)
+        {
+        case EKind::Double:
+            OutNumber = Load<double>();
+            return true;
+
+        case EKind::Int64:
+            OutNumber = static_cast<double>(Load<std::int64_t>());
+            return true;
+
+        case EKind::UInt64:
+            OutNumber = static_cast<double>(Load<std::uint64_t>());
+            return true;
+
+        case EKind::Boolean:
+            OutNumber = Load<bool>() ? 1.0 : 0.0;
+            return true;
+
+        case EKind::SmallString:
+        case EKind::HeapString:
+            return ParseNumber(AsStringView(), OutNumber);
+
+        default:
+            return false;
+        }
+    }
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    inline bool TryGetNumber(float& OutNumber) const
+    {
+        double Double;
+
+        if(TryGetNumber(Double)){
+            OutNumber = static_cast<float>(Double);
+            return true;
+        }
+
+        return false;
+    }
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    inline bool TryGetNumber(std::int8_t& OutNumber) const { return TryGetInteger(OutNumber); }
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    inline bool TryGetNumber(std::int16_t& OutNumber) const { return TryGetInteger(OutNumber); }
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    inline bool TryGetNumber(std::int32_t& OutNumber) const { return TryGetInteger(OutNumber); }
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    inline bool TryGetNumber(std::int64_t& OutNumber) const { return TryGetInteger(OutNumber); }
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    inline bool TryGetNumber(std::uint8_t& OutNumber) const { return TryGetInteger(OutNumber); }
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    inline bool TryGetNumber(std::uint16_t& OutNumber) const { return TryGetInteger(OutNumber); }
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    inline bool TryGetNumber(std::uint32_t& OutNumber) const { return TryGetInteger(OutNumber); }
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    inline bool TryGetNumber(std::uint64_t& OutNumber) const { return TryGetInteger(OutNumber); }
+
+    /** Tries to convert this value to a string, returning false if not possible */
+    bool TryGetString(std::string& OutString) const;
+
+    /** Tries to convert this value to a bool, returning false if not possible */
+    bool TryGetBool(bool& OutBool) const;
+
+    /** Tries to convert this value to an array, returning false if not possible */
+    inline bool TryGetArray(const ArrayType*& OutArray) const
+    {
+        if(Kind != EKind::Array){
+            return false;
+        }
+
+        OutArray = Load<ArrayType*>();
+        return true;
+    }
+
+    /** Tries to convert this value to an array for modification, returning false if not possible */
+    inline bool TryGetArray(ArrayType*& OutArray)
+    {
+        if(Kind != EKind::Array){
+            return false;
+        }
+
+        OutArray = Load<ArrayType*>();
+        return true;
+    }
+
+    /** Tries to convert this value to an object, returning false if not possible */
+    inline bool TryGetObject(const ObjectType*& OutObject) const
+    {
+        if(Kind != EKind::Object){
+            return false;
+        }
+
+        OutObject = Load<ObjectType*>();
+        return true;
+    }
+
+    /** Tries to convert this value to an object for modification, returning false if not possible */
+    inline bool TryGetObject(ObjectType*& OutObject)
+    {
+        if(Kind != EKind::Object){
+            return false;
+        }
+
+        OutObject = Load<ObjectType*>();
+        return true;
+    }
+
+    /**
+     * Attempts to get the field with the specified name.
+     *
+     * @param FieldName The name of the field to get.
+     * @return A pointer to the field, or @c nullptr if this is not an object or the field doesn't exist.
+    */
+    const JsonCompactValue* TryGetField(std::string_view FieldName) const;
+
+    static bool CompareEqual(const JsonCompactValue& Lhs, const JsonCompactValue& Rhs);
+
+protected:
+    enum class EKind : std::uint8_t
+    {
+        None,
+        Null,
+        Boolean,
+        Double,
+        Int64,
+        UInt64,
+        SmallString,
+
+        // Kinds that own a heap block
+        HeapString,
+        Array,
+        Object
+    };
+
+    /** Length-prefixed string data allocated in one block */
+    struct HeapString
+    {
+        std::size_t Length;
+        char Data[1];
+    };
+
+    // Payload bytes: a number, a pointer, or an inline string followed by its length.
+    alignas(8) char Storage[InlineCapacity + 1];
+    EKind Kind;
+
+    template<class T>
+    inline T Load() const
+    {
+        T Value;
+        std::memcpy(&Value, Storage, sizeof(T));
+        return Value;
+    }
+
+    template<class T>
+    inline void Store(const T Value)
+    {
+        std::memcpy(Storage, &Value, sizeof(T));
+    }
+
+    /** Widens an integer to the 64-bit type of the same signedness */
+    template<typename T>
+    static auto ToStoredInteger(const T InNumber)
+    {
+        if constexpr (std::is_signed_v<T>){
+            return static_cast<std::int64_t>(InNumber);
+        }else{
+            return static_cast<std::uint64_t>(InNumber);
+        }
+    }
+
+    /** Converts a stored integer without going through double, falling back to it otherwise */
+    template<typename T>
+    inline bool TryGetInteger(T& OutNumber) const
+    {
+        if(Kind == EKind::Int64){
+            const std::int64_t Int64 = Load<std::int64_t>();
+
+            if constexpr (std::is_signed_v<T>){
+                if(Int64 < std::numeric_limits<T>::min() || Int64 > std::numeric_limits<T>::max()){
+                    return false;
+                }
+            }else{
+                if(Int64 < 0 || static_cast<std::uint64_t>(Int64) > std::numeric_limits<T>::max()){
+                    return false;
+                }
+            }
+
+            OutNumber = static_cast<T>(Int64);
+            return true;
+        }
+
+        if(Kind == EKind::UInt64){
+            const std::uint64_t UInt64 = Load<std::uint64_t>();
+
+            if(UInt64 > static_cast<std::uint64_t>(std::numeric_limits<T>::max())){
+                return false;
+            }
+
+            OutNumber = static_cast<T>(UInt64);
+            return true;
+        }
+
+        if((Kind == EKind::SmallString || Kind == EKind::HeapString) && ParseInteger(AsStringView(), OutNumber)){
+            return true;
+        }
+
+        double Double;
+
+        if(!TryGetNumber(Double)){
+            return false;
+        }
+
+        return ConvertDouble(Double, OutNumber);
+    }
+
+    /** Rounds a double into an integer type, returning false if it's out of range */
+    template<typename T>
+    static bool ConvertDouble(const double Double, T& OutNumber)
+    {
+        // 2^63 and 2^64 are exact as doubles, unlike the numeric limits of the 64-bit types
+        constexpr double Upper = std::is_same_v<T, std::uint64_t> ? 18446744073709551616.0 :
+            (std::is_same_v<T, std::int64_t> ? 9223372036854775808.0 : static_cast<double>(std::numeric_limits<T>::max()) + 1.0);
+
+        if(Double >= static_cast<double>(std::numeric_limits<T>::min()) && Double < Upper){
+            const double Rounded = std::round(Double);
+
+            if(Rounded < Upper){
+                OutNumber = static_cast<T>(Rounded);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /** Parses the whole string as an integer, without going through double */
+    template<typename T>
+    static bool ParseInteger(const std::string_view String, T& OutNumber)
+    {
+        const char* const End = String.data() + String.size();
+        const std::from_chars_result Result = std::from_chars(String.data(), End, OutNumber);
+
+        return Result.ec == std::errc() && Result.ptr == End;
+    }
+
+    static bool ParseNumber(std::string_view String, double& OutNumber);
+
+    /** Stores a string inline if it fits, in a new heap block otherwise; expects no block to be owned */
+    void SetString(std::string_view InString);
+
+    /** Deep-copies Other; expects no block to be owned */
+    void CopyFrom(const JsonCompactValue& Other);
+    void Release();
+};
+
+static_assert(sizeof(JsonCompactValue) == 16, "JsonCompactValue is meant to fit in 16 bytes");
+
+inline bool operator==(const JsonCompactValue& Lhs, const JsonCompactValue& Rhs)
+{
+    return JsonCompactValue::CompareEqual(Lhs, Rhs);
+}
+
+inline bool operator!=(const JsonCompactValue& Lhs, const JsonCompactValue& Rhs)
+{
+    return !JsonCompactValue::CompareEqual(Lhs, Rhs);
+}
+
+} // namespace zexjson
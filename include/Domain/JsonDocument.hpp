@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "JsonValue.hpp"
+#include "JsonNamePool.hpp"
+
+#include <memory_resource>
+
+namespace zexjson {
+
+/**
+ * A monotonic arena that everything in a single document is carved out of.
+ *
+ * Serves as the memory resource of the document's strings, arrays and field
+ * tables as well as its nodes. Individual deallocations are no-ops; all memory
+ * is returned at once when the arena is destroyed. May also hold the pool the
+ * document's field names are interned in.
+*/
+class JsonArena : public std::pmr::memory_resource
+{
+public:
+    /** Size of the first block requested from the heap, in bytes. Later blocks grow geometrically. */
+    static constexpr std::size_t DefaultBlockSize = 64 * 1024;
+
+    explicit JsonArena(std::size_t InitialBlockSize = DefaultBlockSize, bool bInternNames = false);
+
+    JsonArena(const JsonArena&) = delete;
+    JsonArena& operator=(const JsonArena&) = delete;
+
+    inline void* Allocate(std::size_t Size, std::size_t Alignment)
+    {
+        AllocatedBytes += Size;
+        return Resource.allocate(Size, Alignment);
+    }
+
+    /**
+     * Creates a field name, shared with other fields of the same name if names
+     * are interned. Names too long to be stored in place are copied into the
+     * arena, so the name is valid only as long as the arena.
+    */
+    JsonName MakeName(const std::string_view Name);
+
+    /** Returns the number of bytes handed out so far */
+    inline std::size_t GetAllocatedBytes() const { return AllocatedBytes; }
+
+    /** Returns the field name pool, or nullptr if names are not interned */
+    inline JsonNamePool* GetNamePool() const { return NamePool.get(); }
+
+protected:
+    virtual void* do_allocate(std::size_t Size, std::size_t Alignment) override
+    {
+        return Allocate(Size, Alignment);
+    }
+
+    virtual void do_deallocate(void* /* Pointer */, std::size_t /* Size */, std::size_t /* Alignment */) override
+    {
+        // Released together with the arena
+    }
+
+    virtual bool do_is_equal(const std::pmr::memory_resource& Other) const noexcept override
+    {
+        return this == &Other;
+    }
+
+    std::pmr::monotonic_buffer_resource Resource;
+    std::size_t AllocatedBytes;
+
+    // Keeps its table in the arena, so it is declared after and destroyed before Resource
+    std::unique_ptr<JsonNamePool> NamePool;
+};
+
+
+/**
+ * A parsed document that lives in one arena.
+ *
+ * Nodes, strings, arrays, object field tables and field names are all
+ * bump-allocated in the arena in the order they were parsed, instead of one
+ * heap allocation each. Nodes are handed out as shared pointers that own
+ * nothing: they carry no reference count and their destructors never run, so
+ * dropping the document frees the whole tree in a handful of calls to free(),
+ * whatever its size.
+ *
+ * In exchange, every node, string and name taken from the tree is valid only
+ * as long as the document; copy what must outlive it. Values added to the
+ * tree later must be made with MakeShared(), MakeName() and GetResource()
+ * too, or their heap storage is never released.
+ *
+ * Optionally interns field names: each distinct name is then stored once per
+ * document however many objects use it, which pays off for arrays of records.
+*/
+class JsonDocument
+{
+public:
+    /**
+     * @param InitialBlockSize Size of the first arena block, in bytes.
+     * @param bInternNames Whether objects share one copy of each distinct field name.
+    */
+    static std::shared_ptr<JsonDocument> Create(std::size_t InitialBlockSize = JsonArena::DefaultBlockSize, bool bInternNames = false)
+    {
+        return std::shared_ptr<JsonDocument>(new JsonDocument(InitialBlockSize, bInternNames));
+    }
+
+    JsonDocument(const JsonDocument&) = delete;
+    JsonDocument& operator=(const JsonDocument&) = delete;
+
+    /** Constructs a node of this document in its arena; the pointer is valid as long as the document. */
+    template<class T, class... ArgTypes>
+    std::shared_ptr<T> MakeShared(ArgTypes&&... Args) const
+    {
+        T* Node = ::new(Arena->Allocate(sizeof(T), alignof(T))) T(std::forward<ArgTypes>(Args)...);
+
+        // Aliases an empty owner: no control block, and nothing to release one node at a time
+        return std::shared_ptr<T>(std::shared_ptr<void>(), Node);
+    }
+
+    /** Creates a field name, shared with other fields of the same name if names are interned. */
+    inline JsonName MakeName(const std::string_view Name) const { return Arena->MakeName(Name); }
+
+    /** Returns the memory resource strings, arrays and field tables of the document are kept in */
+    inline std::pmr::memory_resource* GetResource() const { return Arena.get(); }
+
+    inline const std::shared_ptr<JsonValue>& GetRoot() const { return Root; }
+
+    inline void SetRoot(std::shared_ptr<JsonValue> InRoot) { Root = std::move(InRoot); }
+
+    /** Returns the number of bytes the document takes up in the arena */
+    inline std::size_t GetArenaSize() const { return Arena->GetAllocatedBytes(); }
+
+    /** Returns the field name pool, or nullptr if names are not interned */
+    inline const JsonNamePool* GetNamePool() const { return Arena->GetNamePool(); }
+
+protected:
+    JsonDocument(std::size_t InitialBlockSize, bool bInternNames);
+
+    std::unique_ptr<JsonArena> Arena;
+    std::shared_ptr<JsonValue> Root;
+};
+
+} // namespace zexjson
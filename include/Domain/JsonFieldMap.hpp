@@ -0,0 +1,161 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "JsonKey.hpp"
+#include "JsonName.hpp"
+
+#if defined(__SSE2__) && defined(__GNUC__)
+#include <emmintrin.h>
+#define JSON_FIELDMAP_SSE2 1
+#else
+#define JSON_FIELDMAP_SSE2 0
+#endif
+
+namespace zexjson {
+
+class JsonValue;
+
+/**
+ * Field table of a JsonObject: a flat vector of name/value pairs that keeps
+ * insertion order.
+ *
+ * Small objects, the common case, are searched linearly: 32-bit tags of the
+ * name hashes sit in their own array and are compared four at a time, and a
+ * name is only compared when its tag matches. Once an object grows past
+ * IndexThreshold fields an open-addressing index over the entries is built,
+ * so large objects keep constant-time lookups.
+ *
+ * Offers the subset of the std::unordered_map interface JsonObject users rely
+ * on (find, operator[], emplace, insert_or_assign, erase, iteration), with
+ * elements of type std::pair<JsonName, std::shared_ptr<JsonValue>>. The
+ * tables are kept in a polymorphic memory resource, the heap unless another
+ * is given.
+*/
+class JsonFieldMap
+{
+public:
+    using value_type = std::pair<JsonName, std::shared_ptr<JsonValue>>;
+    using iterator = std::pmr::vector<value_type>::iterator;
+    using const_iterator = std::pmr::vector<value_type>::const_iterator;
+    using size_type = std::size_t;
+
+    /** Number of fields above which lookups go through the hash index */
+    static constexpr std::size_t IndexThreshold = 8;
+
+    JsonFieldMap() = default;
+
+    /** Keeps the tables in the given memory resource, e.g. the arena of a JsonDocument */
+    explicit JsonFieldMap(std::pmr::memory_resource* Resource) :
+        Entries(Resource), Tags(Resource), Index(Resource)
+        {}
+
+    inline iterator begin() { return Entries.begin(); }
+    inline const_iterator begin() const { return Entries.begin(); }
+    inline iterator end() { return Entries.end(); }
+    inline const_iterator end() const { return Entries.end(); }
+
+    inline std::size_t size() const { return Entries.size(); }
+    inline bool empty() const { return Entries.empty(); }
+
+    inline iterator find(const JsonKey& Key)
+    {
+        return Entries.begin() + FindIndex(Key);
+    }
+
+    inline const_iterator find(const JsonKey& Key) const
+    {
+        return Entries.begin() + FindIndex(Key);
+    }
+
+    inline std::size_t count(const JsonKey& Key) const
+    {
+        return FindIndex(Key) != Entries.size() ? 1 : 0;
+    }
+
+    /** Returns the value of the field, adding an empty one at the end if it doesn't exist */
+    std::shared_ptr<JsonValue>& operator[](const JsonKey& Key);
+
+    /** Adds a field unless one with the same name exists; returns the field and whether it was added */
+    std::pair<iterator, bool> emplace(JsonName Name, std::shared_ptr<JsonValue> Value);
+
+    /** Adds a field, or replaces the value of an existing one in place */
+    std::pair<iterator, bool> insert_or_assign(JsonName Name, std::shared_ptr<JsonValue> Value);
+
+    /** Removes a field, keeping the order of the others */
+    iterator erase(const_iterator Position);
+
+    /** Removes the field with the given name, returning the number of fields removed */
+    std::size_t erase(const JsonKey& Key);
+
+    void reserve(std::size_t Count);
+
+    void clear();
+
+protected:
+    /** Returns the position of the field, or the number of fields if it doesn't exist */
+    inline std::size_t FindIndex(const JsonKey& Key) const
+    {
+        const std::uint32_t Tag = static_cast<std::uint32_t>(Key.GetHash());
+
+        if(Index.empty()){
+            std::size_t i{0};
+
+#if JSON_FIELDMAP_SSE2
+            const __m128i Needle = _mm_set1_epi32(static_cast<int>(Tag));
+
+            for(; i + 4 <= Tags.size(); i += 4){
+                const __m128i Block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Tags.data() + i));
+                unsigned Matches = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(Block, Needle))));
+
+                while(Matches != 0){
+                    const std::size_t Position = i + __builtin_ctz(Matches);
+
+                    if(Entries[Position].first == Key.GetName()){
+                        return Position;
+                    }
+
+                    Matches &= Matches - 1;
+                }
+            }
+#endif // JSON_FIELDMAP_SSE2
+
+            for(; i < Tags.size(); ++i){
+                if(Tags[i] == Tag && Entries[i].first == Key.GetName()){
+                    return i;
+                }
+            }
+
+            return Entries.size();
+        }
+
+        const std::size_t Mask = Index.size() - 1;
+
+        for(std::size_t Slot = Tag & Mask; Index[Slot] != 0; Slot = (Slot + 1) & Mask){
+            const std::size_t i = Index[Slot] - 1;
+
+            if(Tags[i] == Tag && Entries[i].first == Key.GetName()){
+                return i;
+            }
+        }
+
+        return Entries.size();
+    }
+
+    /** Appends a field known not to exist yet */
+    iterator Append(JsonName&& Name, std::uint32_t Tag, std::shared_ptr<JsonValue>&& Value);
+
+    /** Builds the index from scratch with room for at least Count fields */
+    void RebuildIndex(std::size_t Count);
+
+    void InsertIntoIndex(std::size_t Position);
+
+    std::pmr::vector<value_type> Entries;
+
+    // Low 32 bits of the hash of each entry's name, in the same order
+    std::pmr::vector<std::uint32_t> Tags;
+
+    // Open-addressing table of entry positions plus one, zero for free slots; empty below IndexThreshold
+    std::pmr::vector<std::uint32_t> Index;
+};
+
+} // namespace zexjson
@@ -0,0 +1,282 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "JsonValue.hpp"
+#include "JsonObject.hpp"
+
+#include <span>
+
+namespace zexjson{
+
+class JsonFrozenField;
+class JsonFrozenDocument;
+
+/**
+ * A value of a JsonFrozenDocument.
+ *
+ * Values only exist inside their document and are handed out by const
+ * reference or pointer; nothing about them is reference counted and nothing
+ * is written on read, so any number of threads may read a document at once.
+ * Elements of an array and fields of an object sit next to each other in
+ * memory, and strings point into a single character block.
+*/
+class JsonFrozenValue
+{
+public:
+    JsonFrozenValue(const JsonFrozenValue&) = delete;
+    JsonFrozenValue& operator=(const JsonFrozenValue&) = delete;
+
+    /** Returns the Json type of this value */
+    inline EJson GetType() const
+    {
+        switch (Kind)
+        {
+        case EKind::Null:     return EJson::Null;
+        case EKind::Boolean:  return EJson::Boolean;
+        case EKind::Double:
+        case EKind::Int64:
+        case EKind::UInt64:   return EJson::Number;
+        case EKind::String:   return EJson::String;
+        case EKind::Array:    return EJson::Array;
+        case EKind::Object:   return EJson::Object;
+        default:              return EJson::None;
+        }
+    }
+
+    /** Returns how a number is stored; only meaningful if this is a Json Number */
+    inline EJsonNumber GetNumberType() const
+    {
+        return Kind == EKind::Int64 ? EJsonNumber::Int64 : (Kind == EKind::UInt64 ? EJsonNumber::UInt64 : EJsonNumber::Double);
+    }
+
+    /** Returns true if this value is a 'null' */
+    inline bool IsNull() const { return Kind == EKind::Null || Kind == EKind::None; }
+
+    /** Returns this value as a double, returning zero if this is not an Json Number */
+    inline double AsNumber() const
+    {
+        double Number{0.0};
+        TryGetNumber(Number);
+        return Number;
+    }
+
+    /** Returns a view of the string, or an empty view if this is not a Json String */
+    inline std::string_view AsStringView() const
+    {
+        return Kind == EKind::String ? std::string_view(Payload.String, Size) : std::string_view();
+    }
+
+    /** Returns this value as a bool, returning false if not possible */
+    inline bool AsBool() const
+    {
+        bool Bool{false};
+        TryGetBool(Bool);
+        return Bool;
+    }
+
+    /** Returns the elements of an array, or an empty span if this is not a Json Array */
+    inline std::span<const JsonFrozenValue> AsArray() const
+    {
+        return Kind == EKind::Array ? std::span<const JsonFrozenValue>(Payload.Elements, Size) : std::span<const JsonFrozenValue>();
+    }
+
+    /** Returns the fields of an object in insertion order, or an empty span if this is not a Json Object */
+    std::span<const JsonFrozenField> AsObject() const;
+
+    /** Returns the number of elements or fields, or zero if this is not a container */
+    inline std::size_t GetSize() const { return Kind == EKind::Array || Kind == EKind::Object ? Size : 0; }
+
+    /** Returns an element of an array, or @c nullptr if this is not an array or Index is out of range */
+    inline const JsonFrozenValue* GetElement(const std::size_t Index) const
+    {
+        return Kind == EKind::Array && Index < Size ? Payload.Elements + Index : nullptr;
+    }
+
+    /**
+     * Attempts to get the field with the specified name.
+     *
+     * Small objects are scanned, larger ones are binary searched.
+     *
+     * @param FieldName The name of the field to get.
+     * @return A pointer to the field, or @c nullptr if this is not an object or the field doesn't exist.
+    */
+    const JsonFrozenValue* TryGetField(std::string_view FieldName) const;
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    bool TryGetNumber(double& OutNumber) const;
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    bool TryGetNumber(float& OutNumber) const;
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    bool TryGetNumber(std::int8_t& OutNumber) const;
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    bool TryGetNumber(std::int16_t& OutNumber) const;
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    bool TryGetNumber(std::int32_t& OutNumber) const;
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    bool TryGetNumber(std::int64_t& OutNumber) const;
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    bool TryGetNumber(std::uint8_t& OutNumber) const;
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    bool TryGetNumber(std::uint16_t& OutNumber) const;
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    bool TryGetNumber(std::uint32_t& OutNumber) const;
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    bool TryGetNumber(std::uint64_t& OutNumber) const;
+
+    /** Tries to convert this value to a string, returning false if not possible */
+    bool TryGetString(std::string& OutString) const;
+
+    /** Tries to convert this value to a bool, returning false if not possible */
+    bool TryGetBool(bool& OutBool) const;
+
+    static bool CompareEqual(const JsonFrozenValue& Lhs, const JsonFrozenValue& Rhs);
+
+protected:
+    friend class JsonFrozenDocument;
+    friend class JsonFrozenField;
+
+    enum class EKind : std::uint8_t
+    {
+        None,
+        Null,
+        Boolean,
+        Double,
+        Int64,
+        UInt64,
+        String,
+        Array,
+        Object
+    };
+
+    JsonFrozenValue() : Kind(EKind::None), Size(0), Payload{} {}
+
+    template<typename T>
+    bool TryGetInteger(T& OutNumber) const;
+
+    EKind Kind;
+
+    /** Length of a string, or number of elements or fields */
+    std::uint32_t Size;
+
+    union
+    {
+        double Double;
+        std::int64_t Int64;
+        std::uint64_t UInt64;
+        bool Bool;
+        const char* String;
+        const JsonFrozenValue* Elements;
+        const JsonFrozenField* Fields;
+    } Payload;
+};
+
+static_assert(sizeof(JsonFrozenValue) == 16, "JsonFrozenValue is meant to fit in 16 bytes");
+
+
+/** A field of a frozen object */
+class JsonFrozenField
+{
+public:
+    JsonFrozenField(const JsonFrozenField&) = delete;
+    JsonFrozenField& operator=(const JsonFrozenField&) = delete;
+
+    inline std::string_view GetName() const { return std::string_view(Name, NameLength); }
+
+    inline const JsonFrozenValue& GetValue() const { return Value; }
+
+protected:
+    friend class JsonFrozenDocument;
+    friend class JsonFrozenValue;
+
+    JsonFrozenField() : Name(nullptr), NameLength(0), SortedPosition(0) {}
+
+    /** Points into the document's character block, which stores each distinct name once */
+    const char* Name;
+    std::uint32_t NameLength;
+
+    /** Position in the object of the field that comes SortedPosition-th by name, for binary search */
+    std::uint32_t SortedPosition;
+
+    JsonFrozenValue Value;
+};
+
+inline std::span<const JsonFrozenField> JsonFrozenValue::AsObject() const
+{
+    return Kind == EKind::Object ? std::span<const JsonFrozenField>(Payload.Fields, Size) : std::span<const JsonFrozenField>();
+}
+
+
+/**
+ * An immutable snapshot of a Json tree, meant to be built once and read from many threads.
+ *
+ * Creating a snapshot copies the tree into three blocks: one holding every
+ * array element, one holding every object field and one holding the
+ * characters of all strings and distinct field names. Reads go through
+ * JsonFrozenValue and never touch a reference count or any other shared
+ * state, so concurrent readers don't contend on cache lines the way they do
+ * when copying the shared_ptr nodes of a JsonValue tree.
+ *
+ * The snapshot keeps no reference to the tree it was made from. Held through
+ * a shared_ptr to const so that it outlives every reader; pointers into it
+ * stay valid as long as the document is alive.
+*/
+class JsonFrozenDocument
+{
+public:
+    /**
+     * Freezes a tree.
+     *
+     * Lazy values are materialized on the way.
+     *
+     * @param Root The value to copy.
+     * @return The snapshot, or @c nullptr if a string or container doesn't fit 32-bit sizes.
+    */
+    static std::shared_ptr<const JsonFrozenDocument> Create(const JsonValue& Root);
+
+    /**
+     * Freezes an object.
+     *
+     * @param Root The object to copy.
+     * @return The snapshot, or @c nullptr if a string or container doesn't fit 32-bit sizes.
+    */
+    static std::shared_ptr<const JsonFrozenDocument> Create(const JsonObject& Root);
+
+    JsonFrozenDocument(const JsonFrozenDocument&) = delete;
+    JsonFrozenDocument& operator=(const JsonFrozenDocument&) = delete;
+
+    inline const JsonFrozenValue& GetRoot() const { return Root; }
+
+    /** Returns the number of bytes held by the snapshot */
+    inline std::size_t GetAllocatedBytes() const
+    {
+        return sizeof(JsonFrozenDocument) + ElementCount * sizeof(JsonFrozenValue) +
+            FieldCount * sizeof(JsonFrozenField) + CharacterCount;
+    }
+
+protected:
+    JsonFrozenDocument() = default;
+
+    /** Sizes the blocks for the tree, then fills them; returns false if a size overflows */
+    bool Build(const JsonValue* RootValue, const JsonObject* RootObject);
+
+    JsonFrozenValue Root;
+
+    // Allocated once at their final size, so values may point into them
+    std::unique_ptr<JsonFrozenValue[]> Elements;
+    std::unique_ptr<JsonFrozenField[]> Fields;
+    std::unique_ptr<char[]> Characters;
+    std::size_t ElementCount = 0;
+    std::size_t FieldCount = 0;
+    std::size_t CharacterCount = 0;
+};
+
+} // namespace zexjson
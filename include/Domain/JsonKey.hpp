@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "JsonName.hpp"
+
+
+namespace zexjson{
+
+/**
+ * Name of an object field together with its precomputed hash.
+ *
+ * Every JsonObject accessor takes one, so string literals, std::string and
+ * std::string_view are looked up without building a temporary std::string.
+ * Declaring a key once and reusing it, e.g. in a loop over many records,
+ * also skips hashing the name on every lookup:
+ *
+ *     static const JsonKey Timestamp("timestamp");
+ *     for(const auto& Record : Records){ Record->AsObject()->GetNumberField(Timestamp); }
+ *
+ * The key doesn't own the name, so the characters must outlive it.
+*/
+class JsonKey
+{
+public:
+    JsonKey(const std::string_view InName) :
+        Name(InName), Hash(HashName(InName))
+        {}
+
+    JsonKey(const char* InName) :
+        JsonKey(std::string_view(InName))
+        {}
+
+    JsonKey(const std::string& InName) :
+        JsonKey(std::string_view(InName))
+        {}
+
+    JsonKey(const JsonName& InName) :
+        JsonKey(InName.View())
+        {}
+
+    /** Pairs a name with a hash computed earlier by HashName() */
+    JsonKey(const std::string_view InName, const std::size_t InHash) :
+        Name(InName), Hash(InHash)
+        {}
+
+    inline std::string_view GetName() const { return Name; }
+
+    inline std::size_t GetHash() const { return Hash; }
+
+    /** Hashes a field name the same way JsonObject's field table does */
+    static inline std::size_t HashName(const std::string_view InName)
+    {
+        return std::hash<std::string_view>()(InName);
+    }
+
+protected:
+    std::string_view Name;
+    std::size_t Hash;
+};
+
+} // namespace zexjson
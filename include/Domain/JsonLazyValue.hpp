@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "JsonValue.hpp"
+#include "JsonObject.hpp"
+
+
+namespace zexjson{
+
+/**
+ * An object or array that is parsed the first time it is accessed.
+ *
+ * Holds nothing but the range of its Json text. The first call to
+ * TryGetObject()/TryGetArray(), and so AsObject(), AsArray() and every
+ * JsonObject field accessor, parses its direct members: scalars become
+ * regular values, nested objects and arrays become lazy values of their own,
+ * whose range is found by skipping over them with JsonReader::SkipObject() and
+ * SkipArray(). Reading a few fields of a large document therefore only
+ * allocates the containers on the way to them.
+ *
+ * The text is only checked as far as it is read, so errors inside untouched
+ * subtrees go unnoticed. A value that fails to parse reads as empty.
+ * Materializing is not synchronized: a lazy tree must not be accessed from
+ * several threads at once until the parts they share have been touched.
+*/
+class JsonValueLazy : public JsonValue
+{
+public:
+    /**
+     * Creates a lazy value for the object or array Text starts with.
+     *
+     * @param Text Json text, starting with an object or array after optional whitespace.
+     * @param Owner Kept alive by every lazy value of the tree, so Text stays valid.
+     * @return The lazy root, or @c nullptr if Text doesn't start with an object or array.
+    */
+    static std::shared_ptr<JsonValue> Create(std::string_view Text, std::shared_ptr<const void> Owner);
+
+    JsonValueLazy(EJson InType, std::string_view InText, std::shared_ptr<const void> InOwner);
+
+    virtual bool TryGetArray(const JsonArray*& OutArray) const override;
+
+    virtual bool TryGetObject(const std::shared_ptr<JsonObject>*& OutObject) const override;
+
+    /** Returns the Json text of this value, from its opening to its closing bracket */
+    inline std::string_view GetText() const { return Text; }
+
+    /** Returns true once the members of this value have been parsed */
+    inline bool IsMaterialized() const { return State != EState::Pending; }
+
+protected:
+    enum class EState : std::uint8_t
+    {
+        Pending,
+        Ready,
+        Failed
+    };
+
+    /** Parses the direct members of this value, leaving nested containers lazy */
+    void Materialize() const;
+
+    std::string_view Text;
+    std::shared_ptr<const void> Owner;
+
+    mutable std::shared_ptr<JsonObject> Object;
+    mutable JsonArray Array;
+    mutable EState State;
+
+    virtual std::string GetType() const override { return Type == EJson::Object ? "Object" : "Array"; };
+};
+
+} // namespace zexjson
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "Minimal.hpp"
+
+
+namespace zexjson{
+
+/**
+ * Name of an object field, 16 bytes wide.
+ *
+ * Names of up to InlineCapacity characters are stored in place. Longer ones
+ * either own a heap copy, or refer to a copy kept by a JsonNamePool or the
+ * arena of a JsonDocument, in which case moving the name moves only the
+ * pointer. Copying such a name makes an owned copy, so the copy stays valid
+ * once the pool or document is gone. Converts to std::string_view for reading.
+*/
+class JsonName
+{
+public:
+    /** Longest name that is stored without a heap allocation */
+    static constexpr std::size_t InlineCapacity = 14;
+
+    JsonName() : Storage{}, Kind(EKind::Inline) {}
+
+    JsonName(const std::string_view InName);
+
+    JsonName(const char* InName) : JsonName(std::string_view(InName)) {}
+
+    JsonName(const std::string& InName) : JsonName(std::string_view(InName)) {}
+
+    JsonName(const JsonName& Other);
+    JsonName(JsonName&& Other) noexcept;
+    JsonName& operator=(const JsonName& Other);
+    JsonName& operator=(JsonName&& Other) noexcept;
+
+    ~JsonName()
+    {
+        if(Kind == EKind::Owned){
+            ::operator delete(const_cast<Record*>(LoadRecord()));
+        }
+    }
+
+    inline std::string_view View() const
+    {
+        if(Kind == EKind::Inline){
+            return std::string_view(Storage, static_cast<std::uint8_t>(Storage[InlineCapacity]));
+        }
+
+        const Record* Name = LoadRecord();
+        return std::string_view(Name->Chars, Name->Length);
+    }
+
+    inline operator std::string_view() const { return View(); }
+
+    inline std::size_t size() const { return View().size(); }
+
+    inline bool empty() const { return View().empty(); }
+
+    /** Returns a copy of the name as a std::string */
+    inline std::string ToString() const { return std::string(View()); }
+
+    /** Returns true if the name refers to a copy owned by a JsonNamePool or a JsonDocument */
+    inline bool IsInterned() const { return Kind == EKind::Interned; }
+
+    friend inline bool operator==(const JsonName& Lhs, const JsonName& Rhs)
+    {
+        return Lhs.View() == Rhs.View();
+    }
+
+    /** Compares with anything that reads as a string: std::string, std::string_view, literals */
+    template<class StringType, std::enable_if_t<std::is_convertible_v<const StringType&, std::string_view>, int> = 0>
+    friend inline bool operator==(const JsonName& Lhs, const StringType& Rhs)
+    {
+        return Lhs.View() == std::string_view(Rhs);
+    }
+
+protected:
+    friend class JsonNamePool;
+    friend class JsonArena;
+
+    enum class EKind : std::uint8_t
+    {
+        Inline,
+        Owned,
+        Interned
+    };
+
+    /** Length-prefixed name data allocated in one block */
+    struct Record
+    {
+        std::size_t Length;
+        char Chars[1];
+    };
+
+    /** Refers to a record kept alive by a JsonNamePool or a JsonArena */
+    explicit JsonName(const Record* Interned) :
+        Storage{}, Kind(EKind::Interned)
+    {
+        std::memcpy(Storage, &Interned, sizeof(Interned));
+    }
+
+    /** Stores a copy of InName in place or in an owned record; the name must be empty */
+    void SetName(std::string_view InName);
+
+    inline const Record* LoadRecord() const
+    {
+        const Record* Name;
+        std::memcpy(&Name, Storage, sizeof(Name));
+        return Name;
+    }
+
+    // Inline characters followed by their count, or a pointer to a Record
+    alignas(8) char Storage[InlineCapacity + 1];
+    EKind Kind;
+};
+
+static_assert(sizeof(JsonName) == 16, "JsonName is meant to fit in 16 bytes");
+
+inline std::ostream& operator<<(std::ostream& Stream, const JsonName& Name)
+{
+    return Stream << Name.View();
+}
+
+} // namespace zexjson
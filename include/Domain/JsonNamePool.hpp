@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "JsonName.hpp"
+
+#include <unordered_set>
+
+
+namespace zexjson{
+
+/**
+ * Intern table for field names.
+ *
+ * Each distinct name longer than JsonName::InlineCapacity is copied once into
+ * a block owned by the pool; every JsonName interned from it refers to that
+ * copy. Parsing a million records with the same fields therefore stores each
+ * field name once. The pool must outlive every name interned from it, as the
+ * pool of a JsonDocument does the names in its tree. Copies of an interned
+ * name own their characters, so a name copied out of a document outlives it.
+ * Blocks and table are kept in a polymorphic memory resource, the heap unless
+ * another is given.
+*/
+class JsonNamePool
+{
+public:
+    /** Size of the blocks names are copied into, in bytes. */
+    static constexpr std::size_t DefaultBlockSize = 16 * 1024;
+
+    explicit JsonNamePool(std::pmr::memory_resource* InResource = std::pmr::get_default_resource()) :
+        Resource(InResource), Names(InResource), Blocks(InResource), Cursor(nullptr), Remaining(0), ByteSize(0)
+        {}
+
+    JsonNamePool(const JsonNamePool&) = delete;
+    JsonNamePool& operator=(const JsonNamePool&) = delete;
+
+    ~JsonNamePool();
+
+    /** Returns a name sharing the pooled copy of Name, adding it to the pool on first use. */
+    JsonName Intern(std::string_view Name);
+
+    /** Returns the number of distinct names held */
+    inline std::size_t GetNameCount() const { return Names.size(); }
+
+    /** Returns the number of bytes taken by the pooled copies */
+    inline std::size_t GetByteSize() const { return ByteSize; }
+
+protected:
+    /** Hashes pooled records by their characters, so a plain view can be looked up */
+    struct RecordHash
+    {
+        using is_transparent = void;
+
+        inline std::size_t operator()(const std::string_view Name) const { return std::hash<std::string_view>()(Name); }
+        inline std::size_t operator()(const JsonName::Record* Name) const { return (*this)(std::string_view(Name->Chars, Name->Length)); }
+    };
+
+    struct RecordEqual
+    {
+        using is_transparent = void;
+
+        template<class LhsType, class RhsType>
+        inline bool operator()(const LhsType& Lhs, const RhsType& Rhs) const { return GetView(Lhs) == GetView(Rhs); }
+
+    private:
+        static inline std::string_view GetView(const std::string_view Name) { return Name; }
+        static inline std::string_view GetView(const JsonName::Record* Name) { return std::string_view(Name->Chars, Name->Length); }
+    };
+
+    std::pmr::memory_resource* Resource;
+
+    std::pmr::unordered_set<const JsonName::Record*, RecordHash, RecordEqual> Names;
+
+    // Start and size of each block the names are copied into
+    std::pmr::vector<std::pair<char*, std::size_t>> Blocks;
+    char* Cursor;
+    std::size_t Remaining;
+    std::size_t ByteSize;
+};
+
+} // namespace zexjson
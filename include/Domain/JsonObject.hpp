@@ -2,23 +2,35 @@
 
 #include "Minimal.hpp"
 #include "JsonValue.hpp"
+#include "JsonKey.hpp"
+#include "JsonFieldMap.hpp"
 
 namespace zexjson {
 
 class JsonObject
 {
 public:
-    std::unordered_map<std::string, std::shared_ptr<JsonValue>> Values;
+    /** Field table in insertion order; lookups take anything convertible to a JsonKey without allocating */
+    using FieldMap = JsonFieldMap;
+
+    FieldMap Values;
+
+    JsonObject() = default;
+
+    /** Keeps the field table in the given memory resource, e.g. the arena of a JsonDocument */
+    explicit JsonObject(std::pmr::memory_resource* Resource) :
+        Values(Resource)
+        {}
 
     template<EJson JsonType>
-    std::shared_ptr<JsonValue> GetField(const std::string& FieldName) const
+    std::shared_ptr<JsonValue> GetField(const JsonKey& FieldName) const
     {
         const auto FieldIt = Values.find(FieldName);
         if(FieldIt != Values.end()){
-            const auto* [Name, Value] = *FieldIt;
+            const auto& [Name, Value] = *FieldIt;
             if(Value){
-                if(JsonType == EJson::None || (*Value)->Type == JsonType){
-                    return (*Value);
+                if(JsonType == EJson::None || Value->Type == JsonType){
+                    return Value;
                 }else{
                     // LOG: Field of a wrong type
                 }
@@ -36,7 +48,7 @@ public:
      * @param FieldName The name of the field to get.
      * @return A pointer to the field, or @c nullptr if the field doesn't exist.
     */
-   std::shared_ptr<JsonValue> TryGetField(const std::string& FieldName) const
+   std::shared_ptr<JsonValue> TryGetField(const JsonKey& FieldName) const
    {
         const auto FieldIt = Values.find(FieldName);
         return (FieldIt != Values.end() ? FieldIt->second : std::shared_ptr<JsonValue>());
@@ -48,7 +60,7 @@ public:
     * @param FieldName The name of the field to check.
     * @return @c true if the field exists, @c false otherwise.
    */
-    bool HasField(const std::string& FieldName) const
+    bool HasField(const JsonKey& FieldName) const
     {
         const auto FieldIt = Values.find(FieldName);
         
@@ -63,7 +75,7 @@ public:
      * @return A pointer to the field, or @c nullptr if the field doesn't exist.
     */
     template<EJson JsonType>
-    bool HasTypedField(const std::string& FieldName) const
+    bool HasTypedField(const JsonKey& FieldName) const
     {
         const auto FieldIt = Values.find(FieldName);
         
@@ -77,14 +89,14 @@ public:
      * @param FieldName The name of the field to set.
      * @param Value The value to set.
     */
-    void SetField(const std::string& FieldName, const std::shared_ptr<JsonValue>& Value);
+    void SetField(const JsonKey& FieldName, const std::shared_ptr<JsonValue>& Value);
 
     /**
      * Removes the field with the specified name
      * 
      * @param FieldName The name of the field to set. 
     */
-    void RemoveField(const std::string& FieldName);
+    void RemoveField(const JsonKey& FieldName);
 
     /**
      * Gets the field with the specified name as a number.
@@ -94,42 +106,45 @@ public:
      * @param FieldName The name of the field to get.
      * @return The field's value as a number.
     */
-    double GetNumberField(const std::string& FieldName) const;
+    double GetNumberField(const JsonKey& FieldName) const;
 
     /**
      * Gets a numeric field and casts to an std::int32_t
     */
-    inline std::int32_t GetIntegerField(const std::string& FieldName) const
+    inline std::int32_t GetIntegerField(const JsonKey& FieldName) const
     {
         return (std::int32_t)GetNumberField(FieldName);
     }
 
     /** Get the field named FieldName as a number. Returns false if it doesn't exist or cannot be converted. */
-	bool TryGetNumberField(const std::string& FieldName, double& OutNumber) const;
+	bool TryGetNumberField(const JsonKey& FieldName, double& OutNumber) const;
 
 	/** Get the field named FieldName as a number, and makes sure it's within int32 range. Returns false if it doesn't exist or cannot be converted. */
-	bool TryGetNumberField(const std::string& FieldName, std::int32_t& OutNumber) const;
+	bool TryGetNumberField(const JsonKey& FieldName, std::int32_t& OutNumber) const;
 
 	/** Get the field named FieldName as a number, and makes sure it's within uint32 range. Returns false if it doesn't exist or cannot be converted.  */
-	bool TryGetNumberField(const std::string& FieldName, std::uint32_t& OutNumber) const;
+	bool TryGetNumberField(const JsonKey& FieldName, std::uint32_t& OutNumber) const;
+
+	/** Get the field named FieldName as a number. Returns false if it doesn't exist or cannot be converted. */
+	bool TryGetNumberField(const JsonKey& FieldName, std::int64_t& OutNumber) const;
 
 	/** Get the field named FieldName as a number. Returns false if it doesn't exist or cannot be converted. */
-	bool TryGetNumberField(const std::string& FieldName, std::int64_t& OutNumber) const;
+	bool TryGetNumberField(const JsonKey& FieldName, std::uint64_t& OutNumber) const;
 
 	/** Add a field named FieldName with Number as value */
-	void SetNumberField( const std::string& FieldName, double Number );
+	void SetNumberField( const JsonKey& FieldName, double Number );
 
 	/** Get the field named FieldName as a string. */
-	std::string GetStringField(const std::string& FieldName) const;
+	std::string GetStringField(const JsonKey& FieldName) const;
 
 	/** Get the field named FieldName as a string. Returns false if it doesn't exist or cannot be converted. */
-	bool TryGetStringField(const std::string& FieldName, std::string& OutString) const;
+	bool TryGetStringField(const JsonKey& FieldName, std::string& OutString) const;
 
 	/** Get the field named FieldName as an array of strings. Returns false if it doesn't exist or any member cannot be converted. */
-	bool TryGetStringArrayField(const std::string& FieldName, std::vector<std::string>& OutArray) const;
+	bool TryGetStringArrayField(const JsonKey& FieldName, std::vector<std::string>& OutArray) const;
 
     /** Add a field named @c FieldName with value of @c StringValue */
-    void SetStringField(const std::string& FieldName, const std::string& StringValue);
+    void SetStringField(const JsonKey& FieldName, const std::string& StringValue);
 
     /**
 	 * Gets the field with the specified name as a boolean.
@@ -139,22 +154,22 @@ public:
 	 * @param FieldName The name of the field to get.
 	 * @return The field's value as a boolean.
 	 */
-	bool GetBoolField(const std::string& FieldName) const;
+	bool GetBoolField(const JsonKey& FieldName) const;
 
 	/** Get the field named FieldName as a string. Returns false if it doesn't exist or cannot be converted. */
-	bool TryGetBoolField(const std::string& FieldName, bool& OutBool) const;
+	bool TryGetBoolField(const JsonKey& FieldName, bool& OutBool) const;
 
 	/** Set a boolean field named FieldName and value of InValue */
-	void SetBoolField(const std::string& FieldName, bool InValue);
+	void SetBoolField(const JsonKey& FieldName, bool InValue);
 
 	/** Get the field named FieldName as an array. */
-	const std::vector<std::shared_ptr<JsonValue>>& GetArrayField(const std::string& FieldName) const;
+	const JsonArray& GetArrayField(const JsonKey& FieldName) const;
 
 	/** Try to get the field named FieldName as an array, or return false if it's another type */
-	bool TryGetArrayField(const std::string& FieldName, const std::vector<std::shared_ptr<JsonValue>>*& OutArray) const;
+	bool TryGetArrayField(const JsonKey& FieldName, const JsonArray*& OutArray) const;
 
 	/** Set an array field named FieldName and value of Array */
-	void SetArrayField(const std::string& FieldName, const std::vector<std::shared_ptr<JsonValue>>& Array);
+	void SetArrayField(const JsonKey& FieldName, const JsonArray& Array);
 
 	/**
 	 * Gets the field with the specified name as a Json object.
@@ -164,13 +179,21 @@ public:
 	 * @param FieldName The name of the field to get.
 	 * @return The field's value as a Json object.
 	 */
-	const std::shared_ptr<JsonObject>& GetObjectField(const std::string& FieldName) const;
+	const std::shared_ptr<JsonObject>& GetObjectField(const JsonKey& FieldName) const;
 
 	/** Try to get the field named FieldName as an object, or return false if it's another type */
-	bool TryGetObjectField(const std::string& FieldName, const std::shared_ptr<JsonObject>*& OutObject) const;
+	bool TryGetObjectField(const JsonKey& FieldName, const std::shared_ptr<JsonObject>*& OutObject) const;
 
 	/** Set an ObjectField named FieldName and value of JsonObject */
-	void SetObjectField(const std::string& FieldName, const std::shared_ptr<JsonObject>& JsonObject);
+	void SetObjectField(const JsonKey& FieldName, const std::shared_ptr<JsonObject>& JsonObject);
+
+protected:
+    /** Looks a field up without touching its reference count; @c nullptr if it doesn't exist or is unset */
+    inline const JsonValue* FindField(const JsonKey& FieldName) const
+    {
+        const auto FieldIt = Values.find(FieldName);
+        return FieldIt != Values.end() ? FieldIt->second.get() : nullptr;
+    }
 };
 
 } // namespace zexjson
\ No newline at end of file
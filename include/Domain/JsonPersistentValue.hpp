@@ -0,0 +1,194 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "JsonValue.hpp"
+#include "JsonObject.hpp"
+#include "JsonKey.hpp"
+#include "JsonPointer.hpp"
+
+namespace zexjson{
+
+/** Trie node of persistent objects and arrays, defined with their implementation */
+struct JsonPersistentNode;
+
+/**
+ * An immutable Json value whose objects and arrays are updated by making new versions.
+ *
+ * SetField(), RemoveField(), SetElement() and the other updates leave the
+ * value they are called on untouched and return a new version that shares
+ * every unchanged part with it. Objects are hash array mapped tries over the
+ * field names and arrays are tries with 32 slots per node, so an update
+ * copies only the few nodes on the path to the change: O(log n) in the size
+ * of the container, rather than a copy of the whole document. Nested
+ * containers are persistent too, and TrySetAt() updates a value deep inside
+ * a document by rebuilding just the containers on its path.
+ *
+ * Versions never change once made, so threads may keep reading an old
+ * version while a new one is being built. Copying a value only copies two
+ * shared pointers. Scalars are held as shared JsonValue nodes and must not
+ * be modified after being put into a persistent container.
+ *
+ * Objects remember the order fields were first added in; GetFields() and
+ * ToValue() report them in that order.
+*/
+class JsonPersistentValue
+{
+public:
+    using FieldList = std::vector<std::pair<std::string_view, const JsonPersistentValue*>>;
+
+    /** Creates a Json null */
+    JsonPersistentValue();
+
+    /**
+     * Wraps a value; objects and arrays in it are converted into persistent ones.
+     *
+     * Scalars are shared with the tree rather than copied, lazy values are materialized.
+     *
+     * @param Value The value to wrap, where @c nullptr stands for a Json null.
+    */
+    JsonPersistentValue(const std::shared_ptr<const JsonValue>& Value);
+
+    /** Converts an object and everything below it */
+    explicit JsonPersistentValue(const JsonObject& Object);
+
+    /** Returns an object without fields */
+    static JsonPersistentValue MakeObject();
+
+    /** Returns an array without elements */
+    static JsonPersistentValue MakeArray();
+
+    inline EJson GetType() const { return Type; }
+
+    inline bool IsNull() const { return Type == EJson::Null; }
+
+    /** Returns the scalar JsonValue, or @c nullptr for nulls, objects and arrays */
+    inline const std::shared_ptr<const JsonValue>& GetScalar() const { return Scalar; }
+
+    /** Returns this value as a double, returning zero if this is not an Json Number */
+    inline double AsNumber() const { return Scalar ? Scalar->AsNumber() : 0.0; }
+
+    /** Returns this value as a string, returning empty string if not possible */
+    inline std::string AsString() const { return Scalar ? Scalar->AsString() : std::string(); }
+
+    /** Returns this value as a bool, returning false if not possible */
+    inline bool AsBool() const { return Scalar && Scalar->AsBool(); }
+
+    /** Tries to convert this value to a number, returning false if not possible */
+    template<typename NumberType>
+    inline bool TryGetNumber(NumberType& OutNumber) const { return Scalar && Scalar->TryGetNumber(OutNumber); }
+
+    /** Returns the number of fields or elements, or zero if this is not a container */
+    inline std::size_t GetSize() const { return Size; }
+
+    /**
+     * Attempts to get the field with the specified name.
+     *
+     * @param FieldName The name of the field to get.
+     * @return A pointer to the field, or @c nullptr if this is not an object or the field doesn't exist. Valid as long as this version is.
+    */
+    const JsonPersistentValue* TryGetField(const JsonKey& FieldName) const;
+
+    /**
+     * Returns a version of this object with a field set.
+     *
+     * A field that already exists keeps its place in the field order.
+     *
+     * @param FieldName The name of the field to set.
+     * @param Value The value to set.
+     * @return The new version, or an unchanged copy if this is not an object.
+    */
+    JsonPersistentValue SetField(const JsonKey& FieldName, const JsonPersistentValue& Value) const;
+
+    /**
+     * Returns a version of this object without a field.
+     *
+     * @param FieldName The name of the field to remove.
+     * @return The new version, or an unchanged copy if this is not an object or has no such field.
+    */
+    JsonPersistentValue RemoveField(const JsonKey& FieldName) const;
+
+    /** Lists the fields of an object in the order they were added, or nothing if this is not an object */
+    void GetFields(FieldList& OutFields) const;
+
+    /** Returns an element of an array, or @c nullptr if this is not an array or Index is out of range */
+    const JsonPersistentValue* GetElement(std::size_t Index) const;
+
+    /**
+     * Returns a version of this array with an element replaced.
+     *
+     * @return The new version, or an unchanged copy if this is not an array or Index is out of range.
+    */
+    JsonPersistentValue SetElement(std::size_t Index, const JsonPersistentValue& Value) const;
+
+    /** Returns a version of this array with an element appended, or an unchanged copy if this is not an array */
+    JsonPersistentValue PushBack(const JsonPersistentValue& Value) const;
+
+    /** Returns a version of this array without its last element, or an unchanged copy if this is not an array or is empty */
+    JsonPersistentValue PopBack() const;
+
+    /**
+     * Returns a version of this array without an element.
+     *
+     * Removing the last element costs O(log n) like PopBack(); any other
+     * element shifts the ones after it, which rebuilds the array.
+     *
+     * @return The new version, or an unchanged copy if this is not an array or Index is out of range.
+    */
+    JsonPersistentValue RemoveElement(std::size_t Index) const;
+
+    /**
+     * Finds the value a pointer refers to.
+     *
+     * @param Path A pointer without wildcards.
+     * @return The value, or @c nullptr if there is none. Valid as long as this version is.
+    */
+    const JsonPersistentValue* Find(const JsonPointer& Path) const;
+
+    /**
+     * Makes a version with the value a pointer refers to set.
+     *
+     * Every container on the path must exist. The last segment names the
+     * field to set, the element to replace, or, if it is the size of the
+     * array or "-", the element to append.
+     *
+     * @param Path A pointer without wildcards.
+     * @param Value The value to set.
+     * @param OutVersion Receives the new version.
+     * @return @c true on success, @c false if the path can't be followed.
+    */
+    bool TrySetAt(const JsonPointer& Path, const JsonPersistentValue& Value, JsonPersistentValue& OutVersion) const;
+
+    /**
+     * Makes a version without the value a pointer refers to.
+     *
+     * @param Path A non-empty pointer without wildcards.
+     * @param OutVersion Receives the new version.
+     * @return @c true on success, @c false if there is no such value.
+    */
+    bool TryRemoveAt(const JsonPointer& Path, JsonPersistentValue& OutVersion) const;
+
+    /** Copies this value into a regular JsonValue tree, sharing the scalars */
+    std::shared_ptr<JsonValue> ToValue() const;
+
+protected:
+    bool SetAt(const JsonPointer& Path, std::size_t Position, const JsonPersistentValue& Value, JsonPersistentValue& OutVersion) const;
+
+    bool RemoveAt(const JsonPointer& Path, std::size_t Position, JsonPersistentValue& OutVersion) const;
+
+    EJson Type;
+
+    /** Depth of an array trie times 5, i.e. the shift of the top level's index bits */
+    std::uint32_t Shift;
+
+    std::size_t Size;
+
+    /** Order given to the next field added to an object */
+    std::uint64_t NextSequence;
+
+    std::shared_ptr<const JsonValue> Scalar;
+
+    /** Top node of an object or array, @c nullptr while it is empty */
+    std::shared_ptr<const JsonPersistentNode> Root;
+};
+
+} // namespace zexjson
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "JsonValue.hpp"
+#include "JsonObject.hpp"
+
+
+namespace zexjson{
+
+/**
+ * A compiled Json Pointer (RFC 6901), e.g. "/events/3/payload/id".
+ *
+ * Parsed once into segments with their escapes resolved, names pre-hashed
+ * and array indices pre-converted, then evaluated any number of times against
+ * a tree, or against a JsonReader through JsonSerializer::Select() without
+ * building one.
+ *
+ * As an extension, a segment that is exactly "*" matches every member of an
+ * object and every element of an array, so one pointer can select many values.
+ * Pass bAllowWildcards = false to treat "*" as an ordinary member name.
+*/
+class JsonPointer
+{
+public:
+    /** One reference token of the pointer */
+    struct Segment
+    {
+        /** Unescaped member name */
+        std::string Name;
+
+        /** JsonKey::HashName() of Name */
+        std::size_t Hash;
+
+        /** Array index Name stands for, or NoIndex if it isn't a valid one */
+        std::size_t Index;
+
+        bool bWildcard;
+
+        inline bool MatchesName(const std::string_view MemberName) const
+        {
+            return bWildcard || MemberName == Name;
+        }
+
+        inline bool MatchesIndex(const std::size_t ElementIndex) const
+        {
+            return bWildcard || ElementIndex == Index;
+        }
+
+        inline JsonKey GetKey() const { return JsonKey(Name, Hash); }
+    };
+
+    static constexpr std::size_t NoIndex = std::numeric_limits<std::size_t>::max();
+
+    /** The empty pointer, which refers to the whole document */
+    JsonPointer() : bValid(true) {}
+
+    /**
+     * Compiles a pointer. Failures are reported through IsValid() and GetErrorMessage().
+     *
+     * @param Text The pointer: empty, or a sequence of '/'-prefixed segments using ~0 and ~1 for '~' and '/'.
+     * @param bAllowWildcards Whether a "*" segment matches any member or element.
+    */
+    explicit JsonPointer(std::string_view Text, bool bAllowWildcards = true);
+
+    inline bool IsValid() const { return bValid; }
+
+    inline const std::string& GetErrorMessage() const { return ErrorMessage; }
+
+    /** Returns true if any segment is a wildcard, i.e. the pointer may match more than one value */
+    bool HasWildcards() const;
+
+    inline std::size_t GetSegmentCount() const { return Segments.size(); }
+
+    inline const Segment& GetSegment(const std::size_t Position) const { return Segments[Position]; }
+
+    /**
+     * Finds the value the pointer refers to, without copying or allocating anything.
+     *
+     * @param Root The value to evaluate the pointer against.
+     * @return The first match, or @c nullptr if there is none. Valid as long as the tree is.
+    */
+    const JsonValue* Find(const JsonValue& Root) const;
+
+    /**
+     * Finds the value the pointer refers to inside an object.
+     *
+     * @return The first match, or @c nullptr if there is none or the pointer is empty.
+    */
+    const JsonValue* Find(const JsonObject& Root) const;
+
+    /**
+     * Finds every value the pointer refers to, in document order.
+     *
+     * @param Root The value to evaluate the pointer against.
+     * @param OutMatches Receives the matches, appended to its current contents.
+    */
+    void FindAll(const JsonValue& Root, std::vector<const JsonValue*>& OutMatches) const;
+
+protected:
+    std::vector<Segment> Segments;
+    std::string ErrorMessage;
+    bool bValid;
+};
+
+} // namespace zexjson
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "JsonValue.hpp"
+#include "JsonObject.hpp"
+#include "JsonPointer.hpp"
+
+
+namespace zexjson{
+
+class JsonProjectionResult;
+
+/**
+ * A set of Json Pointers compiled into one automaton, so that any number of
+ * paths are extracted from a document in a single pass.
+ *
+ * The pointers are merged into a trie, which is then turned into a
+ * deterministic automaton: every state knows, for each member name or array
+ * index, the single state a child moves to, so the cost per member is one
+ * lookup however many paths there are. Wildcard segments are folded in by
+ * the same construction, at the price of more states when many of them
+ * overlap.
+ *
+ * Paths are identified by their position in the list the projection was
+ * built from. A path without wildcards captures one value, the first match in
+ * document order; a path with wildcards captures every match, including
+ * repeated members of the same name when reading a stream.
+ *
+ * Evaluated against a tree with Project(), or against a JsonReader with
+ * JsonSerializer::Project(), which skips everything no path leads into and
+ * stops reading once every path without wildcards has its value.
+*/
+class JsonProjection
+{
+public:
+    using StateIndex = std::uint32_t;
+
+    static constexpr StateIndex NoState = std::numeric_limits<StateIndex>::max();
+
+    /** The state of the root value */
+    static constexpr StateIndex RootState = 0;
+
+    /** A state of the automaton, standing for the values a set of path prefixes lead to */
+    struct State
+    {
+        struct NameTransition
+        {
+            std::string Name;
+            std::size_t Hash;
+            StateIndex Target;
+        };
+
+        /** Paths that end at values in this state */
+        std::vector<std::uint32_t> Paths;
+
+        /** Transitions on member names */
+        std::vector<NameTransition> Names;
+
+        /** Transitions on array indices */
+        std::vector<std::pair<std::size_t, StateIndex>> Indices;
+
+        /** Transition on any member or element not listed above, only present with wildcards */
+        StateIndex Other = NoState;
+
+        /** Open-addressing table of positions in Names plus one, built when there are many names */
+        std::vector<std::uint32_t> NameTable;
+
+        /** Paths without wildcards that end in this state or below */
+        std::uint32_t PendingPaths = 0;
+
+        /** Whether a path with wildcards ends in this state or below, so it is never done */
+        bool bUnbounded = false;
+
+        inline bool HasTransitions() const
+        {
+            return !Names.empty() || !Indices.empty() || Other != NoState;
+        }
+    };
+
+    /** Number of names above which a state looks them up through NameTable */
+    static constexpr std::size_t NameTableThreshold = 8;
+
+    /**
+     * Compiles a projection. Failures are reported through IsValid() and GetErrorMessage().
+     *
+     * @param Paths The pointers to extract, see JsonPointer.
+     * @param bAllowWildcards Whether a "*" segment matches any member or element.
+    */
+    explicit JsonProjection(const std::vector<std::string_view>& Paths, bool bAllowWildcards = true);
+
+    explicit JsonProjection(std::initializer_list<std::string_view> Paths, bool bAllowWildcards = true) :
+        JsonProjection(std::vector<std::string_view>(Paths), bAllowWildcards)
+        {}
+
+    /** Compiles a projection from pointers compiled earlier */
+    explicit JsonProjection(std::vector<JsonPointer> InPointers);
+
+    inline bool IsValid() const { return bValid; }
+
+    inline const std::string& GetErrorMessage() const { return ErrorMessage; }
+
+    inline std::size_t GetPathCount() const { return Pointers.size(); }
+
+    inline const JsonPointer& GetPointer(const std::size_t Path) const { return Pointers[Path]; }
+
+    inline std::size_t GetStateCount() const { return States.size(); }
+
+    inline const State& GetState(const StateIndex Index) const { return States[Index]; }
+
+    /** Returns the states that count the given path in their PendingPaths */
+    inline const std::vector<StateIndex>& GetPendingStates(const std::size_t Path) const { return PendingStates[Path]; }
+
+    /** Returns the state a member with the given name moves to from a state, or NoState */
+    StateIndex FindMember(StateIndex From, std::string_view Name) const;
+
+    /** Returns the state the element at the given index moves to from a state, or NoState */
+    StateIndex FindElement(StateIndex From, std::size_t Index) const;
+
+    /**
+     * Extracts every path from a tree.
+     *
+     * @param Root The value to evaluate the paths against.
+     * @param OutResult Receives the matches, reset first. Matches share nodes with the tree.
+    */
+    void Project(const std::shared_ptr<JsonValue>& Root, JsonProjectionResult& OutResult) const;
+
+    /**
+     * Matches a value that is in the given state, and everything below it,
+     * adding to the matches already in the result.
+    */
+    void ProjectFrom(StateIndex Index, const std::shared_ptr<JsonValue>& Value, JsonProjectionResult& OutResult) const;
+
+protected:
+    /** Builds the trie and the automaton once the pointers are known to be valid */
+    void Compile();
+
+    void ProjectObject(StateIndex Index, const JsonObject& Object, JsonProjectionResult& OutResult) const;
+
+    void ProjectArray(StateIndex Index, const JsonArray& Array, JsonProjectionResult& OutResult) const;
+
+    std::vector<JsonPointer> Pointers;
+    std::vector<State> States;
+
+    // For each path without wildcards, the states it is pending in
+    std::vector<std::vector<StateIndex>> PendingStates;
+
+    std::string ErrorMessage;
+    bool bValid;
+};
+
+
+/**
+ * Values extracted by a JsonProjection, stored flat: one list of matches for
+ * the whole document, chained per path in document order.
+ *
+ * Reusing one result for many documents keeps its memory.
+*/
+class JsonProjectionResult
+{
+public:
+    /** Clears the matches and prepares for evaluating the given projection */
+    void Reset(const JsonProjection& Projection);
+
+    /** Returns the first match of a path, or an empty pointer if it has none */
+    const std::shared_ptr<JsonValue>& Get(std::size_t Path) const;
+
+    inline bool Has(const std::size_t Path) const { return First[Path] != NoMatch; }
+
+    /** Returns the number of matches of a path */
+    inline std::size_t GetMatchCount(const std::size_t Path) const { return Counts[Path]; }
+
+    /** Appends every match of a path to OutMatches, in document order */
+    void GetAll(std::size_t Path, std::vector<std::shared_ptr<JsonValue>>& OutMatches) const;
+
+    /** Returns the total number of matches over all paths */
+    inline std::size_t GetTotalMatchCount() const { return Matches.size(); }
+
+    /** Returns true if nothing more can match in values of the given state */
+    inline bool IsDone(const JsonProjection::StateIndex Index) const
+    {
+        return Remaining[Index] == 0 && !Projection->GetState(Index).bUnbounded;
+    }
+
+    /** Returns true if every path has all the matches it can take, so the rest of the document can be ignored */
+    inline bool IsComplete() const
+    {
+        return IsDone(JsonProjection::RootState);
+    }
+
+    /** Returns true if a value in the given state would be captured by at least one path */
+    bool Wants(JsonProjection::StateIndex Index) const;
+
+    /** Records a value in the given state for every path ending there that still takes it */
+    void Capture(JsonProjection::StateIndex Index, const std::shared_ptr<JsonValue>& Value);
+
+protected:
+    static constexpr std::uint32_t NoMatch = std::numeric_limits<std::uint32_t>::max();
+
+    struct Match
+    {
+        std::shared_ptr<JsonValue> Value;
+
+        /** Next match of the same path, or NoMatch */
+        std::uint32_t Next;
+    };
+
+    const JsonProjection* Projection = nullptr;
+
+    std::vector<Match> Matches;
+
+    // Per path: first and last match, and number of matches
+    std::vector<std::uint32_t> First;
+    std::vector<std::uint32_t> Last;
+    std::vector<std::uint32_t> Counts;
+
+    // Per state: paths without wildcards below it still waiting for a value
+    std::vector<std::uint32_t> Remaining;
+};
+
+} // namespace zexjson
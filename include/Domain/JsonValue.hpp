@@ -6,6 +6,13 @@
 namespace zexjson{
 
 class JsonObject;
+class JsonValue;
+
+/**
+ * Elements of a Json array. The allocator is polymorphic so that arrays of a
+ * JsonDocument keep their elements in its arena; elsewhere they live on the heap.
+*/
+using JsonArray = std::pmr::vector<std::shared_ptr<JsonValue>>;
 
 class JsonValue
 {
@@ -21,7 +28,7 @@ public:
     bool AsBool() const;
 
     /** Returns this value as an array, returning an empty array reference if not possible */
-    const std::vector<std::shared_ptr<JsonValue>>& AsArray() const;
+    const JsonArray& AsArray() const;
 
     /** Returns this value as an object, throwing an error if this is not an Json Object */
     virtual const std::shared_ptr<JsonObject>& AsObject() const;
@@ -63,7 +70,7 @@ public:
     virtual bool TryGetBool(bool& OutBool) const { return false; }
     
     /** Tries to convert this value to an array, returning false if not possible */
-    virtual bool TryGetArray(const std::vector<std::shared_ptr<JsonValue>>*& OutArray) const { return false; }    
+    virtual bool TryGetArray(const JsonArray*& OutArray) const { return false; }    
 
     /** Tries to convert this value to an object, returning false if not possible */
     virtual bool TryGetObject(const std::shared_ptr<JsonObject>*& OutObject) const { return false; }
@@ -75,7 +82,7 @@ public:
     void AsArgumentType(double& Value);
     void AsArgumentType(std::string& Value);
     void AsArgumentType(bool& Value);
-    void AsArgumentType(std::vector<std::shared_ptr<JsonValue>>& Value);
+    void AsArgumentType(JsonArray& Value);
     void AsArgumentType(std::shared_ptr<JsonObject>& Value);
 
     EJson Type;
@@ -91,15 +98,27 @@ protected:
     void ErrorMessage(std::string_view InType) const;
 };
 
-inline bool operator==(const JsonValue& Lhs, const JsonValue& Rhs);
-inline bool operator!=(const JsonValue& Lhs, const JsonValue& Rhs);
+inline bool operator==(const JsonValue& Lhs, const JsonValue& Rhs)
+{
+    return JsonValue::CompareEqual(Lhs, Rhs);
+}
+
+inline bool operator!=(const JsonValue& Lhs, const JsonValue& Rhs)
+{
+    return !JsonValue::CompareEqual(Lhs, Rhs);
+}
 
 
 /** A Json String Value. */
 class JsonValueString : public JsonValue
 {
 public:
-    JsonValueString(const std::string_view InString);
+    /**
+     * @param InString The characters, copied into the node.
+     * @param Resource Where the characters are kept, e.g. the arena of a JsonDocument.
+    */
+    JsonValueString(const std::string_view InString, std::pmr::memory_resource* Resource = std::pmr::get_default_resource());
+    JsonValueString(const char* InString);
 
     virtual bool TryGetString(std::string& OutString) const override;
     virtual bool TryGetNumber(double& OutNumber) const override;
@@ -109,28 +128,90 @@ public:
     virtual bool TryGetNumber(std::uint64_t& OutNumber) const override;
     virtual bool TryGetBool(bool& OutBool) const override;
 
+    using JsonValue::TryGetNumber;
+
     // Way to check if string value is empty without copying the string
     bool IsEmpty() const;
 
+    /** Returns the string without copying it */
+    inline std::string_view GetString() const { return Value; }
+
 protected:
-    std::string Value;
+    std::pmr::string Value;
 
     virtual std::string GetType() const override { return "String"; };
 };
 
 
-/** A Json Number Value. */
+/**
+ * A Json Number Value.
+ * 
+ * Integers are stored exactly as 64-bit values, so they can be read back
+ * without a round trip through double.
+ */
 class JsonValueNumber : public JsonValue
 {
 public:
     JsonValueNumber(double InNumber);
+    JsonValueNumber(std::int64_t InNumber);
+    JsonValueNumber(std::uint64_t InNumber);
+
+    /** Stores any other integer exactly, e.g. JsonValueNumber(5) or JsonValueNumber(5u) */
+    template<typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    JsonValueNumber(T InNumber) :
+        JsonValueNumber(ToStoredInteger(InNumber))
+        {}
+
+    /** Stores any other floating-point number as a double */
+    template<typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+    JsonValueNumber(T InNumber) :
+        JsonValueNumber(static_cast<double>(InNumber))
+        {}
 
     virtual bool TryGetNumber(double& OutNumber) const override;
+    virtual bool TryGetNumber(std::int8_t& OutNumber) const override;
+    virtual bool TryGetNumber(std::int16_t& OutNumber) const override;
+    virtual bool TryGetNumber(std::int32_t& OutNumber) const override;
+    virtual bool TryGetNumber(std::int64_t& OutNumber) const override;
+    virtual bool TryGetNumber(std::uint8_t& OutNumber) const override;
+    virtual bool TryGetNumber(std::uint16_t& OutNumber) const override;
+    virtual bool TryGetNumber(std::uint32_t& OutNumber) const override;
+    virtual bool TryGetNumber(std::uint64_t& OutNumber) const override;
     virtual bool TryGetBool(bool& OutBool) const override;
     virtual bool TryGetString(std::string& OutString) const override;
 
+    using JsonValue::TryGetNumber;
+
+    /** Returns how the number is stored */
+    inline EJsonNumber GetNumberType() const { return NumberType; }
+
+    /** Compares two numbers, exactly if both are integers */
+    bool Equals(const JsonValueNumber& Other) const;
+
 protected:
-    double Value;
+    union
+    {
+        double Value;
+        std::int64_t Int64Value;
+        std::uint64_t UInt64Value;
+    };
+
+    EJsonNumber NumberType;
+
+    /** Converts a stored integer without going through double, falling back to it for doubles */
+    template<typename T>
+    bool TryGetInteger(T& OutNumber) const;
+
+    /** Widens an integer to the 64-bit type of the same signedness */
+    template<typename T>
+    static auto ToStoredInteger(const T InNumber)
+    {
+        if constexpr (std::is_signed_v<T>){
+            return static_cast<std::int64_t>(InNumber);
+        }else{
+            return static_cast<std::uint64_t>(InNumber);
+        }
+    }
 
     virtual std::string GetType() const override { return "Number"; };
 };
@@ -146,6 +227,8 @@ public:
     virtual bool TryGetBool(bool& OutBool) const override;
     virtual bool TryGetString(std::string& OutString) const override;
 
+    using JsonValue::TryGetNumber;
+
 protected:
     bool Value;
 
@@ -157,12 +240,15 @@ protected:
 class JsonValueArray : public JsonValue
 {
 public: 
-    JsonValueArray(const std::vector<std::shared_ptr<JsonValue>>& InArray);
+    JsonValueArray(const JsonArray& InArray);
+
+    /** Takes the elements over along with the memory resource they are kept in */
+    JsonValueArray(JsonArray&& InArray);
 
-    virtual bool TryGetArray(const std::vector<std::shared_ptr<JsonValue>>*& OutArray) const override;
+    virtual bool TryGetArray(const JsonArray*& OutArray) const override;
 
 protected:
-    std::vector<std::shared_ptr<JsonValue>> Value;
+    JsonArray Value;
 
     virtual std::string GetType() const override { return "Array"; };
 };
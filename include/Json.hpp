@@ -7,4 +7,24 @@
 // Public includes
 
 #include "Domain/JsonValue.hpp"
-#include "Domain/JsonObject.hpp"
\ No newline at end of file
+#include "Domain/JsonName.hpp"
+#include "Domain/JsonNamePool.hpp"
+#include "Domain/JsonKey.hpp"
+#include "Domain/JsonObject.hpp"
+#include "Domain/JsonDocument.hpp"
+#include "Domain/JsonCompactValue.hpp"
+#include "Domain/JsonFrozenDocument.hpp"
+#include "Domain/JsonPersistentValue.hpp"
+#include "Domain/JsonLazyValue.hpp"
+#include "Domain/JsonPointer.hpp"
+#include "Domain/JsonProjection.hpp"
+
+#include "Serialization/JsonReader.hpp"
+#include "Serialization/JsonWriter.hpp"
+#include "Serialization/JsonStreamWriter.hpp"
+#include "Serialization/JsonSerializer.hpp"
+#include "Serialization/JsonThreadPool.hpp"
+#include "Serialization/JsonLinesParser.hpp"
+#include "Serialization/JsonParallelParser.hpp"
+#include "Serialization/JsonPushReader.hpp"
+#include "Serialization/JsonPushParser.hpp"
\ No newline at end of file
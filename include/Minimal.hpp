@@ -2,7 +2,19 @@
 
 #include <unordered_map>
 #include <memory>
+#include <memory_resource>
 #include <vector>
+#include <string>
 #include <string_view>
 #include <istream>
-#include <ostream>
\ No newline at end of file
+#include <ostream>
+#include <sstream>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <limits>
+#include <type_traits>
+#include <utility>
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Minimal.hpp"
+
+
+namespace zexjson{
+
+/**
+ * Supplies input to a JsonReader in contiguous blocks.
+ * 
+ * The reader walks the block handed out by Refill() with raw pointers and only
+ * calls back into the source once the block has been fully consumed.
+*/
+template<class CharType>
+class JsonInputSource
+{
+public:
+    virtual ~JsonInputSource() = default;
+
+    /**
+     * Makes the next block of input available.
+     * 
+     * The previous block may be invalidated by this call.
+     * 
+     * @param OutBegin Receives the first character of the block.
+     * @param OutEnd Receives one past the last character of the block.
+     * @return @c true if a non-empty block was produced, @c false at the end of input or on error.
+    */
+    virtual bool Refill(const CharType*& OutBegin, const CharType*& OutEnd) = 0;
+
+    /** Returns true if the source stopped because of an I/O error rather than the end of input. */
+    virtual bool HasError() const { return false; }
+
+    /**
+     * Returns true if the whole input is handed out as a single block that stays
+     * valid for the lifetime of the source, so the reader may keep views into it.
+    */
+    virtual bool IsContiguous() const { return false; }
+};
+
+
+/** Hands out a caller-owned buffer as a single block, without copying it. */
+template<class CharType>
+class JsonMemoryInputSource : public JsonInputSource<CharType>
+{
+public:
+    /**
+     * Creates a source over the given memory.
+     * 
+     * @param InData The first character of the input. Must outlive the source.
+     * @param InLength Number of characters in the input.
+    */
+    JsonMemoryInputSource(const CharType* InData, std::size_t InLength) :
+        Data(InData), Length(InLength), bConsumed(false)
+        {}
+
+    virtual bool Refill(const CharType*& OutBegin, const CharType*& OutEnd) override
+    {
+        if(bConsumed || Length == 0){
+            return false;
+        }
+
+        OutBegin = Data;
+        OutEnd = Data + Length;
+        bConsumed = true;
+        return true;
+    }
+
+    virtual bool IsContiguous() const override
+    {
+        return true;
+    }
+
+protected:
+    const CharType* Data;
+    std::size_t Length;
+    bool bConsumed;
+};
+
+
+/**
+ * Reads an std::istream in large blocks into an internal buffer.
+ * 
+ * The stream is only ever read forward, so unseekable streams (pipes, sockets,
+ * decompressors) work as well as files.
+*/
+template<class CharType>
+class JsonStreamInputSource : public JsonInputSource<CharType>
+{
+public:
+    /** Default size of a single block read, in bytes. */
+    static constexpr std::size_t DefaultBlockSize = 64 * 1024;
+
+    /**
+     * Creates a source reading from the given stream.
+     * 
+     * @param InStream The stream to read from. Must outlive the source.
+     * @param BlockSize Number of bytes requested from the stream per refill.
+    */
+    explicit JsonStreamInputSource(std::istream* InStream, std::size_t BlockSize = DefaultBlockSize) :
+        Stream(InStream), Buffer(std::max<std::size_t>(BlockSize / sizeof(CharType), 1))
+        {}
+
+    virtual bool Refill(const CharType*& OutBegin, const CharType*& OutEnd) override
+    {
+        if(!Stream || Stream->bad()){
+            return false;
+        }
+
+        Stream->read(reinterpret_cast<char*>(Buffer.data()), Buffer.size() * sizeof(CharType));
+        const std::size_t Count = static_cast<std::size_t>(Stream->gcount()) / sizeof(CharType);
+
+        if(Count == 0){
+            return false;
+        }
+
+        OutBegin = Buffer.data();
+        OutEnd = OutBegin + Count;
+        return true;
+    }
+
+    virtual bool HasError() const override
+    {
+        return Stream && Stream->bad();
+    }
+
+protected:
+    std::istream* Stream;
+    std::vector<CharType> Buffer;
+};
+
+} // namespace zexjson
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "Domain/JsonValue.hpp"
+#include "Serialization/JsonThreadPool.hpp"
+
+
+namespace zexjson{
+
+/** Order in which JsonLinesParser hands out records. */
+enum class EJsonLinesOrder
+{
+    /** Records arrive in input order, on the calling thread */
+    Ordered,
+
+    /** Records arrive as soon as they are parsed, concurrently on the worker threads */
+    Unordered
+};
+
+/**
+ * Parses newline-delimited Json (NDJSON, JSON Lines) held in memory on a thread pool.
+ *
+ * The text is cut into chunks of about ChunkSize bytes right after line
+ * breaks. Json strings can't hold raw line breaks, so every cut falls between
+ * two records as long as each record sits on a single line, which NDJSON
+ * requires. Each chunk is then read by its own reader in line-delimited mode,
+ * see JsonSerializer::DeserializeLines().
+ *
+ * In ordered mode at most a few chunks per worker are parsed ahead of the one
+ * being delivered, so memory stays bounded however large the input is.
+*/
+class JsonLinesParser
+{
+public:
+    /** Receives each record; returning false stops parsing. */
+    using RecordCallback = std::function<bool(std::shared_ptr<JsonValue>)>;
+
+    static constexpr std::size_t DefaultChunkSize = 256 * 1024;
+
+    /** Number of chunks per worker that may be parsed ahead of delivery in ordered mode */
+    static constexpr std::size_t ChunksAheadPerThread = 2;
+
+    /**
+     * Creates a parser with a pool of its own.
+     *
+     * @param ThreadCount Number of workers, or 0 for one per hardware thread.
+     * @param InChunkSize Approximate number of bytes parsed per task.
+    */
+    explicit JsonLinesParser(std::size_t ThreadCount = 0, std::size_t InChunkSize = DefaultChunkSize);
+
+    /**
+     * Creates a parser running on a shared pool.
+     *
+     * @param InPool The pool to run on.
+     * @param InChunkSize Approximate number of bytes parsed per task.
+    */
+    explicit JsonLinesParser(std::shared_ptr<JsonThreadPool> InPool, std::size_t InChunkSize = DefaultChunkSize);
+
+    /**
+     * Parses every record of the text.
+     *
+     * @param Text The input, which must stay alive until the call returns. Records don't refer to it.
+     * @param OnRecord Called with each record. Must be thread-safe in unordered mode.
+     * @param Order Whether records are delivered in input order.
+     * @return @c true if every record was parsed or OnRecord stopped parsing, @c false on a syntax error.
+    */
+    bool Parse(std::string_view Text, const RecordCallback& OnRecord, EJsonLinesOrder Order = EJsonLinesOrder::Ordered);
+
+    /**
+     * Parses every record of a file, mapped into memory.
+     *
+     * @param FilePath Path of the file to parse.
+     * @param OnRecord Called with each record. Must be thread-safe in unordered mode.
+     * @param Order Whether records are delivered in input order.
+     * @return @c true if every record was parsed or OnRecord stopped parsing, @c false if the file can't be read or has a syntax error.
+    */
+    bool ParseFile(const std::string& FilePath, const RecordCallback& OnRecord, EJsonLinesOrder Order = EJsonLinesOrder::Ordered);
+
+    /** Returns the error of the last failed call, naming the line the failing chunk starts at. */
+    inline const std::string& GetErrorMessage() const { return ErrorMessage; }
+
+    inline std::size_t GetThreadCount() const { return Pool->GetThreadCount(); }
+
+protected:
+    bool ParseOrdered(std::string_view Text, const std::vector<std::string_view>& Chunks, const RecordCallback& OnRecord);
+
+    bool ParseUnordered(std::string_view Text, const std::vector<std::string_view>& Chunks, const RecordCallback& OnRecord);
+
+    /** Records the error of a chunk, locating it in the whole text */
+    void SetChunkError(std::string_view Text, std::string_view Chunk, const std::string& Message);
+
+    std::shared_ptr<JsonThreadPool> Pool;
+    std::size_t ChunkSize;
+    std::string ErrorMessage;
+};
+
+} // namespace zexjson
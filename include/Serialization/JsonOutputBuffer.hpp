@@ -0,0 +1,128 @@
+#pragma once
+
+#include "Minimal.hpp"
+
+#include <functional>
+
+
+namespace zexjson{
+
+/**
+ * Byte buffer that Json text is written into.
+ *
+ * Either grows a caller-provided string in place, or collects output in a
+ * fixed-size block and hands it to a stream or a sink function whenever the
+ * block fills up. Every block but the last is exactly the block size, so
+ * memory use stays flat however much is written.
+ * Also knows how to format the Json primitives: numbers and escaped strings.
+*/
+class JsonOutputBuffer
+{
+public:
+    /** Receives each block of output */
+    using SinkFunction = std::function<void(const char* Data, std::size_t Length)>;
+
+    /** Size of the block collected before it is handed to a stream or sink. */
+    static constexpr std::size_t DefaultBlockSize = 64 * 1024;
+
+    /**
+     * Appends to a string. The string holds unspecified bytes past the
+     * written text until Flush() is called, after which the buffer leaves
+     * it alone unless more is written.
+     *
+     * @param InTarget The string to append to.
+     * @param SizeHint Expected size of the output, reserved up front.
+    */
+    explicit JsonOutputBuffer(std::string* InTarget, std::size_t SizeHint = 0);
+
+    /**
+     * Writes to a stream in blocks of BlockSize bytes.
+     *
+     * @param InStream The stream to write to, which must outlive the buffer.
+     * @param BlockSize Size of the blocks handed to the stream.
+    */
+    explicit JsonOutputBuffer(std::ostream* InStream, std::size_t BlockSize = DefaultBlockSize);
+
+    /**
+     * Hands output to a function in blocks of BlockSize bytes.
+     *
+     * @param InSink The function to call with each block.
+     * @param BlockSize Size of the blocks handed to the sink.
+    */
+    explicit JsonOutputBuffer(SinkFunction InSink, std::size_t BlockSize = DefaultBlockSize);
+
+    JsonOutputBuffer(const JsonOutputBuffer&) = delete;
+    JsonOutputBuffer& operator=(const JsonOutputBuffer&) = delete;
+
+    ~JsonOutputBuffer();
+
+    inline void Write(const char Char)
+    {
+        if(Cursor == Limit){
+            MakeRoom(1);
+        }
+
+        *Cursor++ = Char;
+    }
+
+    inline void Write(const char* Data, const std::size_t Length)
+    {
+        if(static_cast<std::size_t>(Limit - Cursor) < Length){
+            WriteSlow(Data, Length);
+            return;
+        }
+
+        std::memcpy(Cursor, Data, Length);
+        Cursor += Length;
+    }
+
+    inline void Write(const std::string_view String)
+    {
+        Write(String.data(), String.size());
+    }
+
+    /** Writes an integer, two digits at a time. */
+    void WriteNumber(std::int64_t Number);
+
+    /** Writes an integer, two digits at a time. */
+    void WriteNumber(std::uint64_t Number);
+
+    /** Writes the shortest representation that reads back as the same double, or null if it's not finite. */
+    void WriteNumber(double Number);
+
+    /** Writes a quoted string, escaping quotes, backslashes and control characters. */
+    void WriteString(std::string_view String);
+
+    /**
+     * Makes everything written so far visible to the target: resizes the
+     * string to the written text, or hands the pending block on.
+     *
+     * Calling it again without writing in between leaves a string untouched.
+    */
+    void Flush();
+
+    /** Returns true if the stream reported a failure */
+    bool HasError() const;
+
+protected:
+    /** Makes room for at least Length more bytes, growing the string or flushing a full block. */
+    void MakeRoom(std::size_t Length);
+
+    /** Writes data that doesn't fit in the space left, a block at a time. */
+    void WriteSlow(const char* Data, std::size_t Length);
+
+    std::string* Target;
+    std::ostream* Stream;
+    SinkFunction Sink;
+
+    // Backing store for block output
+    std::vector<char> Block;
+
+    char* Cursor;
+    char* Limit;
+
+    /** Whether the string was resized to the written text and handed back, see Flush() */
+    bool bFinalized;
+};
+
+} // namespace zexjson
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "Domain/JsonValue.hpp"
+#include "Serialization/JsonThreadPool.hpp"
+
+
+namespace zexjson{
+
+/**
+ * Parses a single large document held in memory on a thread pool.
+ *
+ * The calling thread reads the document with a regular reader and builds
+ * the tree down to the arrays at the split depth. The elements of those
+ * arrays are not tokenized there: objects and arrays among them are skipped
+ * over with JsonReader::SkipObject() and SkipArray(), which only track
+ * brackets and strings, and their text ranges are handed to the workers in
+ * batches of about ChunkSize bytes. Each worker parses its ranges into
+ * independent trees, and once everything is parsed the elements are put
+ * into their arrays in document order. Scalar elements are cheap enough to
+ * be read while splitting.
+ *
+ * Skipping runs many times faster than building trees, so one splitting
+ * thread keeps a good number of workers busy. Work only spreads out for
+ * arrays with many object or array elements, as in the usual dump of
+ * records; a document without such an array at the split depth is parsed
+ * on the calling thread alone.
+*/
+class JsonParallelParser
+{
+public:
+    static constexpr std::size_t DefaultChunkSize = 256 * 1024;
+
+    /**
+     * Creates a parser with a pool of its own.
+     *
+     * @param ThreadCount Number of workers, or 0 for one per hardware thread.
+     * @param InChunkSize Approximate number of bytes parsed per task.
+    */
+    explicit JsonParallelParser(std::size_t ThreadCount = 0, std::size_t InChunkSize = DefaultChunkSize);
+
+    /**
+     * Creates a parser running on a shared pool.
+     *
+     * @param InPool The pool to run on.
+     * @param InChunkSize Approximate number of bytes parsed per task.
+    */
+    explicit JsonParallelParser(std::shared_ptr<JsonThreadPool> InPool, std::size_t InChunkSize = DefaultChunkSize);
+
+    /**
+     * Sets the nesting depth of the arrays whose elements are parsed in parallel.
+     *
+     * 0 splits the root array, 1 the arrays that are members or elements of
+     * the root, as in {"records": [...]}, and so on. Objects at that depth are
+     * read on the calling thread like everything above it.
+    */
+    inline void SetSplitDepth(const std::uint32_t InSplitDepth) { SplitDepth = InSplitDepth; }
+
+    inline std::uint32_t GetSplitDepth() const { return SplitDepth; }
+
+    /**
+     * Parses a whole document.
+     *
+     * @param Text The input, which must stay alive until the call returns. The tree doesn't refer to it.
+     * @param OutValue Receives the root value, either an object or an array.
+     * @return @c true on success, @c false on a syntax error.
+    */
+    bool Parse(std::string_view Text, std::shared_ptr<JsonValue>& OutValue);
+
+    /**
+     * Parses a whole file, mapped into memory.
+     *
+     * @param FilePath Path of the file to parse.
+     * @param OutValue Receives the root value, either an object or an array.
+     * @return @c true on success, @c false if the file can't be read or has a syntax error.
+    */
+    bool ParseFile(const std::string& FilePath, std::shared_ptr<JsonValue>& OutValue);
+
+    /** Returns the error of the last failed call. Errors inside an element name the line the element starts at. */
+    inline const std::string& GetErrorMessage() const { return ErrorMessage; }
+
+    inline std::size_t GetThreadCount() const { return Pool->GetThreadCount(); }
+
+protected:
+    std::shared_ptr<JsonThreadPool> Pool;
+    std::size_t ChunkSize;
+    std::uint32_t SplitDepth;
+    std::string ErrorMessage;
+};
+
+} // namespace zexjson
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "Serialization/JsonOutputBuffer.hpp"
+
+
+namespace zexjson{
+
+/** Print policy that writes Json with no whitespace at all. */
+struct CondensedJsonPrintPolicy
+{
+    static inline void WriteLineTerminator(JsonOutputBuffer& /* Output */) {}
+
+    static inline void WriteTabs(JsonOutputBuffer& /* Output */, std::int32_t /* Count */) {}
+
+    static inline void WriteSpace(JsonOutputBuffer& /* Output */) {}
+};
+
+
+/** Print policy that puts every value on its own line, indented with tabs. */
+struct PrettyJsonPrintPolicy
+{
+    static inline void WriteLineTerminator(JsonOutputBuffer& Output)
+    {
+        Output.Write('\n');
+    }
+
+    static inline void WriteTabs(JsonOutputBuffer& Output, std::int32_t Count)
+    {
+        static constexpr char Tabs[] = "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t";
+        constexpr std::int32_t TabsLength = sizeof(Tabs) - 1;
+
+        for(; Count > TabsLength; Count -= TabsLength){
+            Output.Write(Tabs, TabsLength);
+        }
+
+        if(Count > 0){
+            Output.Write(Tabs, Count);
+        }
+    }
+
+    static inline void WriteSpace(JsonOutputBuffer& Output)
+    {
+        Output.Write(' ');
+    }
+};
+
+} // namespace zexjson
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "Domain/JsonValue.hpp"
+#include "Domain/JsonObject.hpp"
+#include "Serialization/JsonPushReader.hpp"
+
+
+namespace zexjson{
+
+/**
+ * Builds a tree out of a document that arrives piece by piece, e.g. from the network.
+ *
+ * Each Feed() adds everything the piece completes to the tree, so parsing
+ * overlaps with receiving the rest of the document instead of waiting for
+ * all of it. The tree is the one JsonSerializer::Deserialize() builds from
+ * the whole text; containers are closed without recursion, so arbitrarily
+ * deep documents don't grow the call stack.
+*/
+class JsonPushParser
+{
+public:
+    JsonPushParser();
+
+    /**
+     * Parses the next piece of the document as far as it goes.
+     *
+     * @param Data The piece, which need not outlive the call.
+     * @param Length Length of the piece in bytes.
+     * @return @c false on a syntax error, see GetErrorMessage().
+    */
+    bool Feed(const char* Data, std::size_t Length);
+
+    inline bool Feed(const std::string_view Data) { return Feed(Data.data(), Data.size()); }
+
+    /** Returns true once the root value is closed */
+    inline bool IsComplete() const { return Root != nullptr; }
+
+    /**
+     * Ends the input and hands out the tree.
+     *
+     * @param OutValue Receives the root value, either an object or an array.
+     * @return @c false if the document is cut short or not valid Json.
+    */
+    bool Finish(std::shared_ptr<JsonValue>& OutValue);
+
+    inline const std::string& GetErrorMessage() const { return Reader->GetErrorMessage(); }
+
+protected:
+    /** Adds the notations the input read so far completes to the tree */
+    bool ReadAvailable();
+
+    struct StackFrame
+    {
+        EJson Type;
+        JsonName Identifier;
+        JsonArray Array;
+        std::shared_ptr<JsonObject> Object;
+    };
+
+    std::shared_ptr<JsonPushReader> Reader;
+
+    /** Containers opened but not yet closed, innermost last */
+    std::vector<StackFrame> Stack;
+
+    std::shared_ptr<JsonValue> Root;
+};
+
+} // namespace zexjson
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "Serialization/JsonReader.hpp"
+
+
+namespace zexjson{
+
+/** Outcome of JsonPushReader::ReadNext() */
+enum class EJsonPushStatus
+{
+    /** A notation was read */
+    Ready,
+
+    /** The input fed so far ends before the next notation; Feed() more and call ReadNext() again */
+    NeedMoreData,
+
+    /** The root value is closed and all input fed so far was read */
+    Finished,
+
+    /** The input is not valid Json, see GetErrorMessage() */
+    Error
+};
+
+/**
+ * Reads Json that is handed to it piece by piece, e.g. as it arrives from the network.
+ *
+ * Unlike JsonReader, which pulls its input and treats running out of it as
+ * an error, this reader is fed: when the input stops in the middle of a
+ * token, be it a string, a number, a literal or a \\u escape, ReadNext()
+ * returns EJsonPushStatus::NeedMoreData and the next call picks the token up
+ * exactly where it stopped. Pieces may be cut at any byte.
+ *
+ * Tokens that lie wholly within one piece are read in place, the way
+ * JsonStringViewReader reads them; only a token cut in two is copied, so
+ * feeding large pieces costs no more than reading the whole text at once.
+ *
+ * The grammar, the values handed out and the error messages are those of
+ * JsonReader, whose accessors this reader exposes.
+*/
+class JsonPushReader : protected JsonReader<char>
+{
+public:
+    static std::shared_ptr<JsonPushReader> Create()
+    {
+        return std::shared_ptr<JsonPushReader>(new JsonPushReader());
+    }
+
+    virtual ~JsonPushReader() = default;
+
+    /**
+     * Hands the reader the next piece of input.
+     *
+     * The reader reads the piece in place, so it must stay alive until
+     * ReadNext() asks for more data, and as long as any view obtained from it
+     * is in use. Feeding before the previous piece is used up copies what is
+     * left of it.
+     *
+     * @param Data The piece of input, ignored once EndInput() was called or an error occurred.
+     * @param Length Length of the piece in bytes.
+    */
+    void Feed(const char* Data, std::size_t Length);
+
+    /**
+     * Declares that no input follows what was fed so far.
+     *
+     * From then on a document cut short is an error rather than a reason to
+     * ask for more data.
+    */
+    void EndInput();
+
+    /**
+     * Reads the next notation.
+     *
+     * @param Notation Receives the notation read, or EJsonNotation::Error on error.
+     * @return EJsonPushStatus::Ready if a notation was read, see EJsonPushStatus for the others.
+    */
+    EJsonPushStatus ReadNext(EJsonNotation& Notation);
+
+    using JsonReader<char>::GetIdentifier;
+    using JsonReader<char>::MoveIdentifier;
+    using JsonReader<char>::GetIdentifierView;
+    using JsonReader<char>::GetValueAsString;
+    using JsonReader<char>::MoveValueAsString;
+    using JsonReader<char>::GetValueAsStringView;
+    using JsonReader<char>::GetValueAsNumber;
+    using JsonReader<char>::GetValueNumberType;
+    using JsonReader<char>::GetValueAsInt64;
+    using JsonReader<char>::GetValueAsUInt64;
+    using JsonReader<char>::GetValueAsNumberString;
+    using JsonReader<char>::GetValueAsNumberStringView;
+    using JsonReader<char>::GetValueAsBoolean;
+    using JsonReader<char>::GetErrorMessage;
+    using JsonReader<char>::GetLineNumber;
+    using JsonReader<char>::GetCharacterNumber;
+
+protected:
+    /** Which part of a token the input stopped in */
+    enum class EScanState : std::uint8_t
+    {
+        /** Between two tokens */
+        None,
+        String,
+
+        /** Right after a backslash in a string */
+        StringEscape,
+
+        /** Among the hex digits of a \\u escape */
+        StringUnicode,
+        Number,
+        Literal
+    };
+
+    /** What the grammar expects from the next token */
+    enum class EGrammarStep : std::uint8_t
+    {
+        /** The opening bracket of the root */
+        Start,
+
+        /** A comma or closing bracket after a value, or the first key or element of a container */
+        Next,
+
+        /** A key after a comma */
+        Key,
+        Colon,
+        Value
+    };
+
+    JsonPushReader();
+
+    /**
+     * Reads the next token, or as much of it as the input holds.
+     *
+     * @return EJsonPushStatus::Ready once the token is complete.
+    */
+    EJsonPushStatus ScanToken(EJsonToken& OutToken);
+
+    EJsonPushStatus ScanString(EJsonToken& OutToken);
+
+    EJsonPushStatus ScanNumber(EJsonToken& OutToken);
+
+    EJsonPushStatus ScanLiteral(EJsonToken& OutToken);
+
+    /** Asks for more data, or fails with the given message if there is none to come */
+    EJsonPushStatus AtEndOfPiece(const char* Message);
+
+    /** Hands out a value token as the next notation */
+    EJsonPushStatus EmitToken(EJsonToken Token, EJsonNotation& Notation);
+
+    /** Makes the string just read the identifier of the value that follows */
+    void TakeIdentifier();
+
+    void SkipWhiteSpace();
+
+    /** Copies the last identifier and value read out of the input, which is about to go away */
+    void DetachFromInput();
+
+    EScanState ScanState;
+    EGrammarStep Step;
+
+    /** State of JsonReader::NextNumberState() while a number is read */
+    std::int32_t NumberState;
+
+    std::uint32_t HexDigitCount;
+    std::uint32_t HexValue;
+
+    /** A high surrogate escape waiting for its low half, which may arrive in the next piece */
+    std::uint32_t HighSurrogate;
+
+    /** Start of the number being read, while it lies wholly within the current piece */
+    const char* TokenStart;
+
+    /** Whether the token being read was cut and is collected in StringValue */
+    bool bTokenCopied;
+
+    /** Whether the last call stopped in the middle of a notation */
+    bool bReadInProgress;
+
+    bool bInputEnded;
+
+    std::string Literal;
+
+    /** What was left of the previous piece joined with the next one, see Feed() */
+    std::string Backlog;
+};
+
+} // namespace zexjson
@@ -2,6 +2,9 @@
 
 #include "Minimal.hpp"
 #include "Serialization/JsonTypes.hpp"
+#include "Serialization/JsonInputSource.hpp"
+#include "Serialization/JsonUtils.hpp"
+#include "Serialization/JsonScanner.hpp"
 
 
 namespace zexjson{
@@ -37,9 +40,24 @@ template<class CharType>
 class JsonReader
 {
 public:
+    /**
+     * Creates a reader pulling its input from the given stream in large blocks.
+     *
+     * @param Stream The stream to read from. Must outlive the reader.
+    */
     static std::shared_ptr<JsonReader<CharType>> Create(std::istream* const Stream)
     {
-        return std::make_shared(new JsonReader<CharType>(Stream));
+        return Create(std::make_unique<JsonStreamInputSource<CharType>>(Stream));
+    }
+
+    /**
+     * Creates a reader over an arbitrary input source.
+     *
+     * @param Source The source providing the input.
+    */
+    static std::shared_ptr<JsonReader<CharType>> Create(std::unique_ptr<JsonInputSource<CharType>> Source)
+    {
+        return std::shared_ptr<JsonReader<CharType>>(new JsonReader<CharType>(std::move(Source)));
     }
 
 public:
@@ -52,32 +70,52 @@ public:
             return false;
         }
 
-        if(!Stream){
+        if(!Source){
             Notation = EJsonNotation::Error;
-            SetErrorMessage(L"Null Stream");
+            SetErrorMessage("Null Stream");
             return true;
         }
 
-        const bool AtEndOfStream = Stream->eof();
+        const bool AtEndOfStream = IsAtEnd();
+
+        // Line-delimited input may end, or be empty, between any two records
+        const bool bBetweenRecords = bLineDelimited && ParseState.empty();
 
-        if(AtEndOfStream && !FinishedReadingRootObject){
+        if(AtEndOfStream && !FinishedReadingRootObject && !bBetweenRecords){
             Notation = EJsonNotation::Error;
-            SetErrorMessage(L"Improperly formatted.");
+            SetErrorMessage("Improperly formatted.");
             return true;
         }
 
         if(FinishedReadingRootObject && !AtEndOfStream){
-            Notation = EJsonNotation::Error;
-            SetErrorMessage(L"Unexpected additional input found.");
-            return true;
+            if(!bLineDelimited){
+                Notation = EJsonNotation::Error;
+                SetErrorMessage("Unexpected additional input found.");
+                return true;
+            }
+
+            SyncPosition();
+
+            if(LineNumber == RootEndLine){
+                Notation = EJsonNotation::Error;
+                SetErrorMessage("Records must be separated by a line break.");
+                return true;
+            }
         }
 
         if(AtEndOfStream){
             return false;
         }
 
+        if(bBetweenRecords && (!ParseWhiteSpace() || IsAtEnd())){
+            // Nothing but blank lines left
+            return false;
+        }
+
         bool ReadWasSuccess = true;
         Identifier.clear();
+        IdentifierView = std::string_view();
+        bIdentifierInSource = false;
 
         do{
             EJson CurrentState = EJson::None;
@@ -86,14 +124,14 @@ public:
                 CurrentState = ParseState.back();
             }
 
-            switch (expression)
+            switch (CurrentState)
             {
             case EJson::Array:
                 ReadWasSuccess = ReadNextArrayValue( /* OUT */ CurrentToken);
                 break;
 
             case EJson::Object:
-                ReadWasSuccess = ReadNextObjectvalue(/* OUT */ CurrentToken);
+                ReadWasSuccess = ReadNextObjectValue(/* OUT */ CurrentToken);
                 break;
 
             default:
@@ -109,53 +147,180 @@ public:
         Notation = TokenToNotationTable[(std::int32_t)CurrentToken];
         FinishedReadingRootObject = ParseState.size() == 0;
 
+        if(FinishedReadingRootObject){
+            SyncPosition();
+            RootEndLine = LineNumber;
+        }
+
         if(!ReadWasSuccess || Notation == EJsonNotation::Error){
             Notation = EJsonNotation::Error;
 
             if(ErrorMessage.empty()){
-                SetErrorMessage(L"Unknown Error Occured");
+                SetErrorMessage("Unknown Error Occured");
             }
 
             return true;
         }
 
-        if(FinishedReadingRootObject && !Stream->eof()){
+        if(FinishedReadingRootObject && !IsAtEnd()){
             ReadWasSuccess = ParseWhiteSpace();
         }
 
         return ReadWasSuccess;
     }
 
+    /**
+     * Skips the rest of the current object, up to and including its closing brace.
+     *
+     * The skipped text is not tokenized: strings are not decoded and numbers
+     * not converted. It is only checked for balanced brackets and properly
+     * closed strings.
+    */
     bool SkipObject()
     {
-        return ReadUntilMatching(EJsonNotation::ObjectEnd);
+        return SkipContainer(EJson::Object);
     }
 
+    /**
+     * Skips the rest of the current array, up to and including its closing bracket.
+     *
+     * The skipped text is not tokenized, see SkipObject().
+    */
     bool SkipArray()
     {
-        return ReadUntilMatching(EJsonNotation::ArrayEnd);
+        return SkipContainer(EJson::Array);
+    }
+
+    inline virtual const std::string& GetIdentifier() const
+    {
+        if(bIdentifierInSource){
+            Identifier.assign(IdentifierView);
+            IdentifierView = Identifier;
+            bIdentifierInSource = false;
+        }
+
+        return Identifier;
+    }
+
+    /**
+     * Moves the identifier of the current value out of the reader.
+     * 
+     * Intended for builders that keep the identifier anyway; GetIdentifier()
+     * returns an empty string afterwards.
+    */
+    inline std::string MoveIdentifier()
+    {
+        if(bIdentifierInSource){
+            bIdentifierInSource = false;
+            return std::string(std::exchange(IdentifierView, std::string_view()));
+        }
+
+        IdentifierView = std::string_view();
+        return std::move(Identifier);
     }
 
-    inline virtual const std::string& GetIdentifier() const { return Identifier; }
+    /**
+     * Returns the identifier of the current value without copying it.
+     * 
+     * Points straight into the input when it came from a contiguous source and
+     * contained no escapes. Only valid until the next call to ReadNext().
+    */
+    inline std::string_view GetIdentifierView() const
+    {
+        return IdentifierView;
+    }
 
     inline virtual const std::string& GetValueAsString() const
     {
         assert(CurrentToken == EJsonToken::String);
+
+        if(bStringInSource){
+            StringValue.assign(StringView);
+            StringView = StringValue;
+            bStringInSource = false;
+        }
+
         return StringValue;
     }
 
+    /**
+     * Moves the current string value out of the reader.
+     * 
+     * Intended for builders that keep the value anyway; GetValueAsString()
+     * returns an empty string afterwards.
+    */
+    inline std::string MoveValueAsString()
+    {
+        assert(CurrentToken == EJsonToken::String);
+
+        if(bStringInSource){
+            bStringInSource = false;
+            return std::string(std::exchange(StringView, std::string_view()));
+        }
+
+        StringView = std::string_view();
+        return std::move(StringValue);
+    }
+
+    /**
+     * Returns the current string value without copying it.
+     * 
+     * Points straight into the input when it came from a contiguous source and
+     * contained no escapes. Only valid until the next call to ReadNext().
+    */
+    inline std::string_view GetValueAsStringView() const
+    {
+        assert(CurrentToken == EJsonToken::String);
+        return StringView;
+    }
+
     inline double GetValueAsNumber() const
     {
         assert(CurrentToken == EJsonToken::Number);
         return NumberValue;
-    } 
+    }
+
+    /** Returns how the current number is best stored, based on its lexical form. */
+    inline EJsonNumber GetValueNumberType() const
+    {
+        assert(CurrentToken == EJsonToken::Number);
+        return NumberType;
+    }
+
+    /** Returns the current number exactly, if GetValueNumberType() is EJsonNumber::Int64. */
+    inline std::int64_t GetValueAsInt64() const
+    {
+        assert(CurrentToken == EJsonToken::Number && NumberType == EJsonNumber::Int64);
+        return Int64Value;
+    }
+
+    /** Returns the current number exactly, if GetValueNumberType() is EJsonNumber::UInt64. */
+    inline std::uint64_t GetValueAsUInt64() const
+    {
+        assert(CurrentToken == EJsonToken::Number && NumberType == EJsonNumber::UInt64);
+        return UInt64Value;
+    }
 
     inline const std::string& GetValueAsNumberString() const
     {
         assert(CurrentToken == EJsonToken::Number);
+
+        if(bStringInSource){
+            StringValue.assign(StringView);
+            StringView = StringValue;
+            bStringInSource = false;
+        }
+
         return StringValue;
     }
 
+    /** Returns the text of the current number without copying it. Only valid until the next call to ReadNext(). */
+    inline std::string_view GetValueAsNumberStringView() const
+    {
+        assert(CurrentToken == EJsonToken::Number);
+        return StringView;
+    }
+
     inline bool GetValueAsBoolean() const
     {
         assert((CurrentToken == EJsonToken::True || CurrentToken == EJsonToken::False));
@@ -169,99 +334,435 @@ public:
 
     inline const std::uint32_t GetLineNumber() const
     {
+        SyncPosition();
         return LineNumber;
     }
 
     inline const std::uint32_t GetCharacterNumber() const
     {
+        SyncPosition();
         return CharacterNumber;
     }
 
+    /**
+     * Switches reading of newline-delimited Json (NDJSON, JSON Lines) on or off.
+     *
+     * In this mode the input is a sequence of root objects or arrays, each
+     * starting on a new line. Once a root is closed, ReadNext() goes on with
+     * the next one instead of reporting additional input, and returns false
+     * when only whitespace is left. Blank lines are ignored.
+    */
+    inline void SetLineDelimited(const bool bInLineDelimited)
+    {
+        bLineDelimited = bInLineDelimited;
+    }
+
+    inline bool IsLineDelimited() const
+    {
+        return bLineDelimited;
+    }
+
+    /**
+     * Switches to the two-stage engine. The whole input is indexed up front,
+     * see JsonScanner::BuildStructuralIndex(), and tokens are then read by
+     * jumping from one indexed position to the next instead of scanning the
+     * whitespace and punctuation in between.
+     *
+     * Produces the same notations and values as the default engine. Invalid
+     * input is rejected as well, though the message may differ: an invalid
+     * character right after a number or literal is reported as an invalid
+     * token, and stray quotes or backslashes that skipping lets through inside
+     * a skipped container may be reported after it.
+     *
+     * Indexing costs a pass over the whole input and four bytes per indexed
+     * character, so it only pays off when most of the input is read. Picking a
+     * few values out of a large document is faster with the default engine,
+     * which skips what isn't needed without indexing it.
+     *
+     * Only available for char input held in memory in one piece, as with
+     * JsonStringReader, JsonStringViewReader and JsonFileReader, and only before
+     * the first ReadNext().
+     *
+     * @return @c true if the reader uses the index from now on.
+    */
+    bool UseStructuralIndex()
+    {
+        if constexpr (!std::is_same_v<CharType, char>){
+            return false;
+        }else{
+            if(bIndexed){
+                return true;
+            }
+
+            // Either reading has started already or there is no input
+            if(Cursor != nullptr || IsAtEnd() || !bContiguousInput){
+                return false;
+            }
+
+            if(static_cast<std::size_t>(BufferEnd - Cursor) > std::numeric_limits<std::uint32_t>::max()){
+                return false;
+            }
+
+            JsonScanner::BuildStructuralIndex(Cursor, BufferEnd, StructuralIndex);
+
+            IndexBase = Cursor;
+            IndexEnd = BufferEnd;
+            LineStart = SyncedPosition = Cursor;
+            NextStructural = 0;
+            bIndexed = true;
+            return true;
+        }
+    }
+
+    inline bool IsUsingStructuralIndex() const
+    {
+        return bIndexed;
+    }
+
 protected:
 
     /* Hidden default constructor. */
     JsonReader() :
-        ParserState(), CurrentToken(EJsonToken::None), Stream(nullptr),
-        Identifier(), ErrorMessage(), StringValue(), NumberValue(0.f),
-        LineNumber(1), CharacterNumber(0), BoolValue(false), FinishedReadingRootObject(false)
+        ParseState(), CurrentToken(EJsonToken::None), Source(nullptr), Cursor(nullptr), BufferEnd(nullptr),
+        Identifier(), ErrorMessage(), StringValue(), IdentifierView(), StringView(), NumberValue(0.f),
+        Int64Value(0), UInt64Value(0), NumberType(EJsonNumber::Double),
+        LineNumber(1), CharacterNumber(0), RootEndLine(0), BoolValue(false), FinishedReadingRootObject(false),
+        bLineDelimited(false), bIdentifierInSource(false), bStringInSource(false), bContiguousInput(false),
+        StructuralIndex(), NextStructural(0), IndexBase(nullptr), IndexEnd(nullptr), LineStart(nullptr), SyncedPosition(nullptr),
+        bIndexed(false)
         {}
 
     /**
      * Creates and initializes a new instance with the given input.
-     * 
-     * @param InStream A stream providing the input.
+     *
+     * @param InSource A source providing the input.
     */
-    JsonReader(std::istream* InStream) :
-        ParserState(), CurrentToken(EJsonToken::None), Stream(InStream),
-        Identifier(), ErrorMessage(), StringValue(), NumberValue(0.f),
-        LineNumber(1), CharacterNumber(0), BoolValue(false), FinishedReadingRootObject(false)
+    JsonReader(std::unique_ptr<JsonInputSource<CharType>> InSource) :
+        ParseState(), CurrentToken(EJsonToken::None), Source(std::move(InSource)), Cursor(nullptr), BufferEnd(nullptr),
+        Identifier(), ErrorMessage(), StringValue(), IdentifierView(), StringView(), NumberValue(0.f),
+        Int64Value(0), UInt64Value(0), NumberType(EJsonNumber::Double),
+        LineNumber(1), CharacterNumber(0), RootEndLine(0), BoolValue(false), FinishedReadingRootObject(false),
+        bLineDelimited(false), bIdentifierInSource(false), bStringInSource(false), bContiguousInput(false),
+        StructuralIndex(), NextStructural(0), IndexBase(nullptr), IndexEnd(nullptr), LineStart(nullptr), SyncedPosition(nullptr),
+        bIndexed(false)
         {}
 
-    bool Serialize(void* V, std::int64_t Length)
+    /** Pulls the next block from the source. Returns false if there is no more input. */
+    bool RefillBuffer()
+    {
+        if(!Source || !Source->Refill(Cursor, BufferEnd)){
+            Cursor = BufferEnd = nullptr;
+            return false;
+        }
+
+        bContiguousInput = Source->IsContiguous();
+        return true;
+    }
+
+    /** Returns true once the current block is consumed and the source has nothing more to give. */
+    inline bool IsAtEnd()
+    {
+        return Cursor == BufferEnd && !RefillBuffer();
+    }
+
+    /** Consumes a single character from the input. */
+    inline bool ReadChar(CharType& OutChar)
+    {
+        if(Cursor == BufferEnd && !RefillBuffer()){
+            SetErrorMessage("Stream I/O Error.");
+            return false;
+        }
+
+        OutChar = *Cursor++;
+        return true;
+    }
+
+    /**
+     * Looks at the next character without consuming it.
+     *
+     * Used instead of reading one character too far and seeking back, so the
+     * reader never needs to rewind its input.
+     *
+     * @return @c false if there is no more input.
+    */
+    inline bool PeekChar(CharType& OutChar)
     {
-        Stream->read(V, Length);
-        if(Stream->fail()){
-            SetErrorMessage(L"Stream I/O Error.");
+        if(Cursor == BufferEnd && !RefillBuffer()){
             return false;
-        } 
+        }
+
+        OutChar = *Cursor;
         return true;
     }
 
     std::vector<EJson> ParseState;
     EJsonToken CurrentToken;
 
-    std::unique_ptr<std::istream> Stream;
-    std::string Identifier;
+    std::unique_ptr<JsonInputSource<CharType>> Source;
+    const CharType* Cursor;
+    const CharType* BufferEnd;
+    mutable std::string Identifier;
     std::string ErrorMessage;
-    std::string StringValue;
+    mutable std::string StringValue;
+    mutable std::string_view IdentifierView;
+    mutable std::string_view StringView;
     double NumberValue;
-    std::uint32_t LineNumber;
-    std::uint32_t CharacterNumber;
+    std::int64_t Int64Value;
+    std::uint64_t UInt64Value;
+    EJsonNumber NumberType;
+    // Brought up to date lazily by the indexed engine, see SyncPosition()
+    mutable std::uint32_t LineNumber;
+    mutable std::uint32_t CharacterNumber;
+
+    /** Line the last root value was closed on */
+    std::uint32_t RootEndLine;
+
     bool BoolValue;
     bool FinishedReadingRootObject;
+    bool bLineDelimited;
+
+    /** Whether IdentifierView/StringView point into the input rather than into Identifier/StringValue */
+    mutable bool bIdentifierInSource;
+    mutable bool bStringInSource;
+    bool bContiguousInput;
+
+    /** Offsets of the structural characters from IndexBase, see UseStructuralIndex() */
+    std::vector<std::uint32_t> StructuralIndex;
+
+    /** Position in StructuralIndex of the next token */
+    std::size_t NextStructural;
+
+    // The indexed input, which outlives the reader's own view of it once the source runs out
+    const CharType* IndexBase;
+    const CharType* IndexEnd;
+
+    // Start of the line SyncPosition() last counted up to, and how far it counted
+    mutable const CharType* LineStart;
+    mutable const CharType* SyncedPosition;
+
+    bool bIndexed;
+
+    /**
+     * The indexed engine doesn't count lines as it goes, since it never looks
+     * at most of the input. Instead they are counted here, from where the last
+     * call left off, whenever the position is needed.
+    */
+    void SyncPosition() const
+    {
+        if(!bIndexed){
+            return;
+        }
+
+        const CharType* const Position = Cursor != nullptr ? Cursor : IndexEnd;
+
+        if(Position <= SyncedPosition){
+            return;
+        }
+
+        const CharType* Scan = SyncedPosition;
+
+        while(const void* const LineBreak = std::memchr(Scan, '\n', static_cast<std::size_t>(Position - Scan))){
+            ++LineNumber;
+            LineStart = Scan = static_cast<const CharType*>(LineBreak) + 1;
+        }
+
+        CharacterNumber = static_cast<std::uint32_t>(Position - LineStart);
+        SyncedPosition = Position;
+    }
 
-private:
     void SetErrorMessage(const std::string& Message)
     {
-        ErrorMessage = Message + 
-            " Line: " + std::to_string(LineNumber) + 
+        SyncPosition();
+
+        ErrorMessage = Message +
+            " Line: " + std::to_string(LineNumber) +
             " Ch: " + std::to_string(CharacterNumber);
     }
 
-    bool ReadUntilMatching(const EJsonNotation ExpectedNotation)
+private:
+    /**
+     * Moves past the closing bracket of the innermost open container, tracking
+     * only string boundaries and bracket depth, a 64-byte block at a time where
+     * the input allows. Leaves the reader as if it had just read that bracket.
+    */
+    bool SkipContainer(const EJson ContainerType)
     {
-        std::uint32_t ScopeCount = 0;
-        EJsonNotation Notation;
+        if(!ErrorMessage.empty()){
+            return false;
+        }
 
-        while(ReadNext(Notation)){
-            if(ScopeCount == 0 && Notation == ExpectedNotation){
-                return true;
+        if(ParseState.empty() || ParseState.back() != ContainerType){
+            SetErrorMessage(ContainerType == EJson::Object ? "Not inside an object to skip." : "Not inside an array to skip.");
+            return false;
+        }
+
+        if constexpr (std::is_same_v<CharType, char>){
+            if(bIndexed){
+                return SkipContainerIndexed(ContainerType);
+            }
+        }
+
+        std::uint32_t Depth = 0;
+        bool bInString = false;
+        bool bEscaped = false;
+
+        while(true){
+            if(Cursor == BufferEnd && !RefillBuffer()){
+                SetErrorMessage(bInString ? "String Token Abruptly Ended." : "Improperly formatted.");
+                return false;
+            }
+
+            if constexpr (std::is_same_v<CharType, char>){
+                // Whole blocks first, then whatever they leave is scanned below
+                JsonSkipState State;
+                State.Depth = Depth;
+                State.bInString = bInString;
+                State.bEscaped = bEscaped;
+
+                const char* const Stop = JsonScanner::SkipContainerBlocks(Cursor, BufferEnd, State);
+
+                if(State.LineBreaks){
+                    LineNumber += State.LineBreaks;
+                    CharacterNumber = static_cast<std::uint32_t>(Stop - State.LastLineBreak - 1);
+                }else{
+                    CharacterNumber += static_cast<std::uint32_t>(Stop - Cursor);
+                }
+
+                Cursor = Stop;
+
+                if(State.bClosed){
+                    ++Cursor;
+                    ++CharacterNumber;
+                    return FinishSkip(*Stop == '}' ? EJson::Object : EJson::Array, ContainerType);
+                }
+
+                Depth = State.Depth;
+                bInString = State.bInString;
+                bEscaped = State.bEscaped;
+
+                if(Cursor == BufferEnd){
+                    continue;
+                }
+            }
+
+            if(bEscaped){
+                // May be a quote, so it is stepped over unseen
+                ++Cursor;
+                ++CharacterNumber;
+                bEscaped = false;
+                continue;
+            }
+
+            const CharType* RunStart = Cursor;
+
+            if constexpr (std::is_same_v<CharType, char>){
+                Cursor = bInString ? JsonScanner::FindStringSpecial(Cursor, BufferEnd) : JsonScanner::FindStructural(Cursor, BufferEnd);
+            }else{
+                while(Cursor != BufferEnd && !(bInString ? IsStringSpecial(*Cursor) : IsStructural(*Cursor))){
+                    ++Cursor;
+                }
+            }
+
+            CharacterNumber += static_cast<std::uint32_t>(Cursor - RunStart);
+
+            if(Cursor == BufferEnd){
+                continue;
+            }
+
+            const CharType Char = *Cursor++;
+            ++CharacterNumber;
+
+            if(bInString){
+                if(Char == CharType('\"')){
+                    bInString = false;
+                }else if(Char == CharType('\\')){
+                    bEscaped = true;
+                }else{
+                    SetErrorMessage("Unescaped control character in string.");
+                    return false;
+                }
+
+                continue;
             }
 
-            switch (Notation)
+            switch (Char)
             {
-            case EJsonNotation::ObjectStart:
-            case EJsonNotation::ArrayStart:
-                ScopeCount++;
+            case CharType('\"'):
+                bInString = true;
                 break;
 
-            case EJsonNotation::ObjectEnd:
-            case EJsonNotation::ArrayEnd:
-                ScopeCount--;
+            case CharType('{'):
+            case CharType('['):
+                ++Depth;
                 break;
-            
-            case EJsonNotation::Boolean:
-            case EJsonNotation::Null:
-            case EJsonNotation::Number:
-            case EJsonNotation::String:
+
+            case CharType('}'):
+            case CharType(']'):
+                if(Depth == 0){
+                    return FinishSkip(Char == CharType('}') ? EJson::Object : EJson::Array, ContainerType);
+                }
+
+                --Depth;
+                break;
+
+            default:
+                ++LineNumber;
+                CharacterNumber = 0;
                 break;
-            
-            case EJsonNotation::Error:
-                return false;
             }
         }
+    }
+
+    /**
+     * Skips with the block scanner, which gets through the text faster than
+     * walking the index entry by entry, then looks up where to go on in the index.
+    */
+    bool SkipContainerIndexed(const EJson ContainerType)
+    {
+        // Counted incrementally while skipping, as in the default engine
+        SyncPosition();
+
+        bIndexed = false;
+        const bool bSkipped = SkipContainer(ContainerType);
+        bIndexed = true;
+
+        const CharType* const Position = Cursor != nullptr ? Cursor : IndexEnd;
+        const std::uint32_t Offset = static_cast<std::uint32_t>(Position - IndexBase);
+
+        NextStructural = static_cast<std::size_t>(std::lower_bound(StructuralIndex.begin(), StructuralIndex.end(), Offset) - StructuralIndex.begin());
+        LineStart = Position - CharacterNumber;
+        SyncedPosition = Position;
+
+        return bSkipped;
+    }
+
+    /** Pops the skipped container and leaves the reader right after its closing bracket */
+    bool FinishSkip(const EJson ClosedType, const EJson ContainerType)
+    {
+        if(ClosedType != ContainerType){
+            SetErrorMessage("Mismatched closing bracket.");
+            return false;
+        }
+
+        ParseState.pop_back();
+        CurrentToken = ClosedType == EJson::Object ? EJsonToken::CurlyClose : EJsonToken::SquareClose;
+
+        Identifier.clear();
+        IdentifierView = std::string_view();
+        bIdentifierInSource = false;
+
+        FinishedReadingRootObject = ParseState.empty();
+
+        if(FinishedReadingRootObject){
+            SyncPosition();
+            RootEndLine = LineNumber;
+        }
 
-        return !Stream->bad();
+        if(FinishedReadingRootObject && !IsAtEnd()){
+            return ParseWhiteSpace();
+        }
+
+        return true;
     }
 
     bool ReadStart(EJsonToken& Token)
@@ -277,7 +778,7 @@ private:
         }
 
         if(Token != EJsonToken::CurlyOpen && Token != EJsonToken::SquareOpen){
-            SetErrorMessage(L"Open Curly or Square Brace token expected, but not found.");
+            SetErrorMessage("Open Curly or Square Brace token expected, but not found.");
             return false;
         }
 
@@ -291,14 +792,14 @@ private:
 
         if(!NextToken(Token)){
             return false;
-        } 
+        }
 
         if(Token == EJsonToken::CurlyClose){
             return true;
         }else{
             if(bCommaPrepend){
                 if(Token != EJsonToken::Comma){
-                    SetErrorMessage(L"Comma token expected, but not found.");
+                    SetErrorMessage("Comma token expected, but not found.");
                     return false;
                 }
 
@@ -310,10 +811,19 @@ private:
             }
 
             if(Token != EJsonToken::String){
-                SetErrorMessage(L"String token expected, but not found.")
+                SetErrorMessage("String token expected, but not found.");
+                return false;
+            }
+
+            if(bStringInSource){
+                IdentifierView = StringView;
+                bIdentifierInSource = true;
+            }else{
+                // The key is not needed as a value anymore, so take its buffer instead of copying it
+                Identifier.swap(StringValue);
+                IdentifierView = Identifier;
             }
-            
-            Identifier = StringValue;
+
             Token = EJsonToken::None;
 
             if(!NextToken(Token)){
@@ -321,7 +831,7 @@ private:
             }
 
             if(Token != EJsonToken::Colon){
-                SetErrorMessage(L"Colon token expected, but not found.");
+                SetErrorMessage("Colon token expected, but not found.");
                 return false;
             }
 
@@ -350,7 +860,7 @@ private:
         }else{
             if(bCommaPrepend){
                 if(Token != EJsonToken::Comma){
-                    SetErrorMessage(L"Comma token expected, but not found.");
+                    SetErrorMessage("Comma token expected, but not found.");
                     return false;
                 }
 
@@ -367,10 +877,20 @@ private:
 
     bool NextToken(EJsonToken& OutToken)
     {
-        while(!Stream->eof()){
+        if constexpr (std::is_same_v<CharType, char>){
+            if(bIndexed){
+                return NextIndexedToken(OutToken);
+            }
+        }
+
+        if(!ParseWhiteSpace()){
+            return false;
+        }
+
+        while(!IsAtEnd()){
             CharType Char;
 
-            if(!Serialize(&Char, sizeof(CharType))){
+            if(!ReadChar(Char)){
                 return false;
             }
             ++CharacterNumber;
@@ -385,337 +905,544 @@ private:
             }
 
             if(!IsWhitespace(Char)){
-                if(IsJsonNumber(Char)){
-                    if(!ParseNumberToken(Char)){
-                        return false;
-                    }
+                return ParseToken(Char, OutToken);
+            }
+        }
 
-                    OutToken = EJsonToken::Number;
-                    return true;
-                }
+        SetErrorMessage("Invalid Json Token.");
+        return false;
+    }
 
-                switch (Char)
-                {
-                case CharType('{'):
-                    OutToken = EJsonToken::CurlyOpen;
-                    ParseState.push_back(EJson::Object);
-                    return true;
-                
-                case CharType('}'):
-                {
-                    OutToken = EJsonToken::CurlyClose;
-                    if(ParseState.size()){
-                        ParseState.pop_back();
-                        return true;
-                    }else{
-                        SetErrorMessage(L"Unknown state reached while parsing Json token.");
-                        return false;
-                    }
-                }
-                }
+    /** Reads the token at the next indexed position */
+    bool NextIndexedToken(EJsonToken& OutToken)
+    {
+        if(NextStructural == StructuralIndex.size()){
+            Cursor = IndexEnd;
+            SetErrorMessage("Invalid Json Token.");
+            return false;
+        }
 
-                case CharType('['):
-                    OutToken = EJsonToken::SquareOpen;
-                    ParseState.push_back(EJson::Array);
-                    return true;
+        Cursor = IndexBase + StructuralIndex[NextStructural++];
 
-                case CharType(']'):
-                {
-                    OutToken = EJsonToken::SquareClose;
-                    if(ParseState.size()){
-                        ParseState.pop_back();
-                        return true;
-                    }else{
-                        SetErrorMessage(L"Unknown state reached while parsing Json token.");
-                        return false;
-                    }
-                }
+        const CharType Char = *Cursor++;
 
-                case CharType(':'):
-                    OutToken = EJsonToken::Colon;
-                    return true;
-                
-                case CharType(','):
-                    OutToken = EJsonToken::Comma;
-                    return true;
-                
-                case CharType('\"'):
-                {
-                    if(!ParseStringToken()){
-                        return false;
-                    }
+        if(!ParseToken(Char, OutToken)){
+            return false;
+        }
 
-                    OutToken = EJsonToken::String;
-                    return true;
-                }
+        // Characters glued to a number or literal are not indexed, so they'd be silently dropped
+        if(OutToken == EJsonToken::Number || OutToken == EJsonToken::True || OutToken == EJsonToken::False || OutToken == EJsonToken::Null){
+            // The cursor is cleared if the token ran up to the end of input
+            if(Cursor != nullptr && Cursor != IndexEnd && !IsWhitespace(*Cursor) && !IsTokenBoundary(*Cursor)){
+                SetErrorMessage("Invalid Json Token.");
+                return false;
+            }
+        }
 
-                case CharType('t'): case CharType('T'):
-                case CharType('f'): case CharType('F'):
-                {
-                    std::string Test;
-                    Test += Char;
-
-                    while(!Stream->eof()){
-                        if(!Serialize(&Char, sizeof(CharType))){
-                            return false;
-                        }
-
-                        if(IsAlphaNumber(Char)){
-                            ++CharacterNumber;
-                            Test += Char;
-                        }else{
-                            // backtrack and break
-                            Stream->seekg(Stream->tellg() - sizeof(CharType));
-                            break;
-                        }
-                    }
+        return true;
+    }
 
-                    if(Test == L"False"){
-                        BoolValue = false;
-                        OutToken = EJsonToken::False;
-                        return true;
-                    }
+    /** Reads the token starting with the given character, which has just been consumed */
+    bool ParseToken(CharType Char, EJsonToken& OutToken)
+    {
+        if(IsJsonNumber(Char)){
+            if(!ParseNumberToken(Char)){
+                return false;
+            }
 
-                    if(Test == L"True"){
-                        BoolValue = true;
-                        OutToken = EJsonToken::True;
-                        return true;
-                    }
+            OutToken = EJsonToken::Number;
+            return true;
+        }
 
-                    if(Test == L"Null"){
-                        OutToken = EJsonToken::Null;
-                        return true;
-                    }
+        switch (Char)
+        {
+        case CharType('{'):
+            OutToken = EJsonToken::CurlyOpen;
+            ParseState.push_back(EJson::Object);
+            return true;
 
-                    SetErrorMessage(L"Invalid Json Token. Check that your member names have quotes around them!");
-                    return false;
-                }
+        case CharType('}'):
+        {
+            OutToken = EJsonToken::CurlyClose;
+            if(ParseState.size()){
+                ParseState.pop_back();
+                return true;
+            }else{
+                SetErrorMessage("Unknown state reached while parsing Json token.");
+                return false;
+            }
+        }
 
-                default:
-                    SetErrorMessage(L"Invalid Json Token.");
-                    return false;
+        case CharType('['):
+            OutToken = EJsonToken::SquareOpen;
+            ParseState.push_back(EJson::Array);
+            return true;
+
+        case CharType(']'):
+        {
+            OutToken = EJsonToken::SquareClose;
+            if(ParseState.size()){
+                ParseState.pop_back();
+                return true;
+            }else{
+                SetErrorMessage("Unknown state reached while parsing Json token.");
+                return false;
             }
         }
 
-        SetErrorMessage(L"Invalid Json Token.");
-        return false;
+        case CharType(':'):
+            OutToken = EJsonToken::Colon;
+            return true;
+
+        case CharType(','):
+            OutToken = EJsonToken::Comma;
+            return true;
+
+        case CharType('\"'):
+        {
+            if(!ParseStringToken()){
+                return false;
+            }
+
+            OutToken = EJsonToken::String;
+            return true;
+        }
+
+        case CharType('t'): case CharType('T'):
+        case CharType('f'): case CharType('F'):
+        case CharType('n'): case CharType('N'):
+        {
+            std::string Test;
+            Test += static_cast<char>(Char);
+
+            while(PeekChar(Char) && IsAlphaNumber(Char)){
+                ++Cursor;
+                ++CharacterNumber;
+                Test += static_cast<char>(Char);
+            }
+
+            if(JsonUtils::EqualsIgnoreCase(Test, "False")){
+                BoolValue = false;
+                OutToken = EJsonToken::False;
+                return true;
+            }
+
+            if(JsonUtils::EqualsIgnoreCase(Test, "True")){
+                BoolValue = true;
+                OutToken = EJsonToken::True;
+                return true;
+            }
+
+            if(JsonUtils::EqualsIgnoreCase(Test, "Null")){
+                OutToken = EJsonToken::Null;
+                return true;
+            }
+
+            SetErrorMessage("Invalid Json Token. Check that your member names have quotes around them!");
+            return false;
+        }
+
+        default:
+            SetErrorMessage("Invalid Json Token.");
+            return false;
+        }
     }
 
     bool ParseStringToken()
     {
         std::string String;
+        bool bFirstRun = true;
+
+        // A high surrogate escape waiting for the low surrogate escape that must follow it
+        std::uint32_t HighSurrogate = 0;
 
         while(true){
-            if(Stream->eof()){
-                SetErrorMessage(L"String Token Abruptly Ended.");
+            if(IsAtEnd()){
+                SetErrorMessage("String Token Abruptly Ended.");
                 return false;
             }
 
-            CharType Char;
-            if(!Serialize(&Char, sizeof(CharType))){
+            // Copy the run of plain characters straight out of the current block
+            const CharType* RunStart = Cursor;
+
+            if constexpr (std::is_same_v<CharType, char>){
+                Cursor = JsonScanner::FindStringSpecial(Cursor, BufferEnd);
+            }else{
+                while(Cursor != BufferEnd && !IsStringSpecial(*Cursor)){
+                    ++Cursor;
+                }
+            }
+
+            if constexpr (std::is_same_v<CharType, char>){
+                // A string without escapes in a contiguous input is handed out as a view into it
+                if(bFirstRun && bContiguousInput && Cursor != BufferEnd && *Cursor == CharType('\"')){
+                    StringView = std::string_view(RunStart, Cursor - RunStart);
+                    bStringInSource = true;
+                    CharacterNumber += static_cast<std::uint32_t>(Cursor - RunStart) + 1;
+                    ++Cursor;
+                    return true;
+                }
+            }
+
+            bFirstRun = false;
+            String.append(RunStart, Cursor);
+            CharacterNumber += static_cast<std::uint32_t>(Cursor - RunStart);
+
+            if(HighSurrogate != 0 && Cursor != RunStart){
+                SetErrorMessage("Unpaired UTF-16 surrogate in string.");
                 return false;
             }
+
+            if(Cursor == BufferEnd){
+                continue;
+            }
+
+            CharType Char = *Cursor++;
             ++CharacterNumber;
 
             if(Char == CharType('\"')){
+                if(HighSurrogate != 0){
+                    SetErrorMessage("Unpaired UTF-16 surrogate in string.");
+                    return false;
+                }
+
                 break;
             }
 
-            if(Char == CharType('\\')){
-                if(!Serialize(&Char, sizeof(CharType))){
-                    return false;
-                }
-                ++CharacterNumber;
+            if(Char != CharType('\\')){
+                SetErrorMessage("Unescaped control character in string.");
+                return false;
+            }
+
+            if(!ReadChar(Char)){
+                return false;
+            }
+            ++CharacterNumber;
+
+            if(HighSurrogate != 0 && Char != CharType('u')){
+                SetErrorMessage("Unpaired UTF-16 surrogate in string.");
+                return false;
+            }
+
+            switch (Char)
+            {
+            case CharType('\"'): case CharType('\\'): case CharType('/'): String += static_cast<char>(Char); break;
+            case CharType('f'): String += '\f'; break;
+            case CharType('r'): String += '\r'; break;
+            case CharType('n'): String += '\n'; break;
+            case CharType('b'): String += '\b'; break;
+            case CharType('t'): String += '\t'; break;
+            case CharType('u'):
+            // 4 hex digits, like \uFF00, which is 16 bit number that we would usually see as 0xFF00
+            {
+                std::int32_t HexNum = 0;
+
+                for(std::int32_t Radix = 3; Radix >= 0; --Radix){
+                    if(IsAtEnd()){
+                        SetErrorMessage("String token abruptly ended.");
+                        return false;
+                    }
+
+                    if(!ReadChar(Char)){
+                        return false;
+                    }
+                    ++CharacterNumber;
+
+                    const std::int32_t HexDigit = JsonUtils::ParseHexDigit(Char);
 
-                switch (Char)
-                {
-                case CharType('\"'): case CharType('\\'): case CharType('/'): String += Char; break;
-                case CharType('f'): String += CharType('\f'); break;
-                case CharType('r'): String += CharType('\r'); break;
-                case CharType('n'): String += CharType('\n'); break;
-                case CharType('b'): String += CharType('\b'); break;
-                case CharType('t'): String += CharType('\t'); break;
-                case CharType('u'):
-                // 4 hex digits, like \uFF00, which is 16 bit number that we would usually see as 0xFF00
-                {
-                    std::int32_t HexNum = 0;
-
-                    for(std::int32_t Radix = 3; Radix >= 0; --Radix){
-                        if(Stream->eof()){
-                            SetErrorMessage(L"String token abruptly ended.");
-                            return false;
-                        }
-
-                        if(!Serialize(&Char, sizeof(CharType))){
-                            return false;
-                        }
-                        ++CharacterNumber;
-
-                        const std::int32_t HexDigit = JsonUtils::ParseHexDigit(Char); // <- Add to JsonUtils
-                        
-                        if(HexDigit == 0 && Char != CharType('0')){
-                            SetErrorMessage(L"Invalid hexadecimal digit parsed.");
-                            return false;
-                        }
-
-                        HexNum += HexDigit * static_cast<std::int32_t>(std::pow(16, Radix));
+                    if(HexDigit == 0 && Char != CharType('0')){
+                        SetErrorMessage("Invalid hexadecimal digit parsed.");
+                        return false;
                     }
 
-                    String += HexNum;
-                    break;
+                    HexNum += HexDigit << (4 * Radix);
                 }
-                default:
-                    SetErrorMessage(L"Bad Json escaped char.");
-                    break;
+
+                if(!JsonUtils::AppendUtf16Unit(String, static_cast<std::uint32_t>(HexNum), HighSurrogate)){
+                    SetErrorMessage("Unpaired UTF-16 surrogate in string.");
+                    return false;
                 }
-            }else{
-                String += Char;
+
+                break;
+            }
+            default:
+                SetErrorMessage("Bad Json escaped char.");
+                return false;
             }
         }
 
         StringValue = std::move(String);
-        
+        StringView = StringValue;
+        bStringInSource = false;
+
         return true;
     }
 
     bool ParseNumberToken(CharType FirstChar)
     {
-        std::string String;
         std::int32_t State = 0;
-        bool UseFirstChar = true;
         bool StateError = false;
 
+        // FirstChar was just consumed from the current block, so the number starts right before the cursor
+        const CharType* RunStart = Cursor - 1;
+        CharType Char = FirstChar;
+        StringValue.clear();
+
         while(true){
-            if(Stream->eof()){
-                SetErrorMessage(L"Number token abruptly ended.");
-                return false;
+            // The following code doesn't actually derive the Json Number:
+            // that is handled by ConvertNumberToken below.
+            // This code only ensures the Json Number is EXACTLY to specification
+            State = NextNumberState(State, Char);
+            StateError = State < 0;
+
+            if(StateError){
+                break;
             }
 
-            CharType Char;
-            if(UseFirstChar){
-                Char = FirstChar;
-                UseFirstChar = false;
-            }else{
-                if(!Serialize(&Char, sizeof(CharType))){
+            // Only a number spanning two blocks needs to be copied out of the input
+            if(Cursor == BufferEnd){
+                StringValue.append(RunStart, Cursor);
+
+                if(!RefillBuffer()){
+                    SetErrorMessage("Number token abruptly ended.");
                     return false;
                 }
-                ++CharacterNumber;
-            }
 
-            // The following code doesn't actually derive the Json Number:
-            // that is handled by the function std::stod below.
-            // This code only ensures the Json Number is EXACTLY to specification
-            if(IsJsonNumber(Char)){
-                // Ensure number follows Json format before converting
-                // This switch statement is derived from a finite state automata
-                // derived from the Json spec. A table was not used for simplicity.
-                switch (State){
-                    case 0:
-                        if(Char == CharType('-')) { State = 1; }
-                        else if(Char == CharType('0')) { State = 2; }
-                        else if(IsNonZeroDigit(Char))) { State = 3; }
-                        else { StateError = true; }
-                        break;
-                    
-                    case 1:
-                        if(Char == CharType('0')) { State = 2; }
-                        else if(IsNonZeroDigit(Char)) { State = 3; }
-                        else { StateError = true; }
-                        break;
-                    
-                    case 2:
-                        if(Char == CharType('.')) { State = 4; }
-                        else if(Char == CharType('e') || Char == CharType('E')) { State = 5; }
-                        else { StateError = true; }
-                        break;
-                    
-                    case 3:
-                        if(IsDigit(Char)) { State = 3; }
-                        else if(Char == CharType('.')) { State = 4; }
-                        else if(Char == CharType('e') || Char == CharType('E')) { State = 5; }
-                        else { StateError = true; }
-                        break;
-                    
-                    case 4:
-                        if(IsDigit(Char)) { State = 6; }
-                        else { StateError = true; }
-                        break;
-                    
-                    case 5:
-                        if(Char == CharType('-') || Char == CharType('+')) { State = 7; }
-                        else if(IsDigit(Char)) { State = 8; }
-                        else { StateError = true; }
-                        break;
-                    
-                    case 6:
-                        if(IsDigit(Char)) { State = 6; }
-                        else if(Char == CharType('e') || Char == CharType('E')) { State = 5; }
-                        else{ StateError = true; }
-                        break;
-
-                    case 7: 
-                        if(IsDigit(Char)) { State = 8; }
-                        else{ StateError = true; }
-                        break;
-                    
-                    case 8:
-                        if(IsDigit(Char)) { State = 8; }
-                        else{ StateError = true; }
-                        break;
-                    
-                    default:
-                        SetErrorMessage(L"Unknown state reached in Json Number token.");
-                        return false;
-                }
+                RunStart = Cursor;
+            }
 
-                if(StateError){
-                    break;
-                }
+            Char = *Cursor;
 
-                String += Char;
-            }else{
-                // backtrack once because we read a non-number character
-                Stream->seekg(Stream->tellg() - sizeof(CharType));
-                --CharacterNumber;
-                // And now the number is fully tokenized
+            if(!IsJsonNumber(Char)){
+                // Leave the non-number character for the next token
                 break;
             }
+
+            ++Cursor;
+            ++CharacterNumber;
         }
 
         // Ensure the number has followed valid Json format
-        if(!StateError && (State == 2 || State == 3 || State == 6 || State == 8)){
-            StringValue = String;
-            NumberValue = std::stod(String);
-            return true;
+        if(StateError || !IsNumberComplete(State)){
+            SetErrorMessage("Poorly formed Json Number token.");
+            return false;
         }
 
-        SetErrorMessage(L"Poorly formed Json Number token.");
-        return false;
+        bStringInSource = false;
+
+        if constexpr (std::is_same_v<CharType, char>){
+            bStringInSource = bContiguousInput && StringValue.empty();
+        }
+
+        if(bStringInSource){
+            StringView = std::string_view(reinterpret_cast<const char*>(RunStart), Cursor - RunStart);
+        }else{
+            StringValue.append(RunStart, Cursor);
+            StringView = StringValue;
+        }
+
+        // States 2 and 3 have neither a fraction nor an exponent
+        return ConvertNumberToken(StringView, State == 2 || State == 3);
+    }
+
+protected:
+    // The token rules below are shared with JsonPushReader
+
+    /**
+     * Advances the automaton that checks a number against the Json grammar by one character.
+     *
+     * The automaton starts in state 0 and a number may end in any state
+     * IsNumberComplete() accepts. States 2 and 3 are integers, i.e. have
+     * neither a fraction nor an exponent. It is written as a switch rather
+     * than a table for simplicity.
+     *
+     * @return The next state, or -1 if the character can't continue the number.
+    */
+    static std::int32_t NextNumberState(const std::int32_t State, const CharType Char)
+    {
+        switch (State){
+            case 0:
+                if(Char == CharType('-')) { return 1; }
+                if(Char == CharType('0')) { return 2; }
+                if(IsNonZeroDigit(Char)) { return 3; }
+                return -1;
+
+            case 1:
+                if(Char == CharType('0')) { return 2; }
+                if(IsNonZeroDigit(Char)) { return 3; }
+                return -1;
+
+            case 2:
+                if(Char == CharType('.')) { return 4; }
+                if(Char == CharType('e') || Char == CharType('E')) { return 5; }
+                return -1;
+
+            case 3:
+                if(IsDigit(Char)) { return 3; }
+                if(Char == CharType('.')) { return 4; }
+                if(Char == CharType('e') || Char == CharType('E')) { return 5; }
+                return -1;
+
+            case 4:
+                if(IsDigit(Char)) { return 6; }
+                return -1;
+
+            case 5:
+                if(Char == CharType('-') || Char == CharType('+')) { return 7; }
+                if(IsDigit(Char)) { return 8; }
+                return -1;
+
+            case 6:
+                if(IsDigit(Char)) { return 6; }
+                if(Char == CharType('e') || Char == CharType('E')) { return 5; }
+                return -1;
+
+            case 7:
+            case 8:
+                if(IsDigit(Char)) { return 8; }
+                return -1;
+
+            default:
+                return -1;
+        }
+    }
+
+    /** Returns true if a number may end in the given state of NextNumberState() */
+    static bool IsNumberComplete(const std::int32_t State)
+    {
+        return State == 2 || State == 3 || State == 6 || State == 8;
+    }
+
+    /**
+     * Converts the text of a validated number, straight from the input when possible.
+     *
+     * Integers that fit are kept exactly as 64-bit values, everything else goes
+     * through a correctly rounded, locale-independent double conversion.
+    */
+    bool ConvertNumberToken(const std::string_view Text, const bool bIsInteger)
+    {
+        const char* const Begin = Text.data();
+        const char* const End = Begin + Text.size();
+
+        if(bIsInteger){
+            if(Text[0] == '-'){
+                std::int64_t Integer;
+                if(std::from_chars(Begin, End, Integer).ec == std::errc()){
+                    NumberType = EJsonNumber::Int64;
+                    Int64Value = Integer;
+                    NumberValue = static_cast<double>(Integer);
+                    return true;
+                }
+            }else{
+                std::uint64_t Integer;
+                if(std::from_chars(Begin, End, Integer).ec == std::errc()){
+                    if(Integer <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())){
+                        NumberType = EJsonNumber::Int64;
+                        Int64Value = static_cast<std::int64_t>(Integer);
+                    }else{
+                        NumberType = EJsonNumber::UInt64;
+                        UInt64Value = Integer;
+                    }
+
+                    NumberValue = static_cast<double>(Integer);
+                    return true;
+                }
+            }
+        }
+
+        NumberType = EJsonNumber::Double;
+
+        const std::from_chars_result Result = std::from_chars(Begin, End, NumberValue);
+
+        if(Result.ec == std::errc::result_out_of_range){
+            // Saturate like strtod: infinity on overflow, zero on underflow
+            const double Magnitude = IsDecimalExponentPositive(Text) ? std::numeric_limits<double>::infinity() : 0.0;
+            NumberValue = Text[0] == '-' ? -Magnitude : Magnitude;
+        }else if(Result.ec != std::errc()){
+            SetErrorMessage("Poorly formed Json Number token.");
+            return false;
+        }
+
+        return true;
+    }
+
+    /** Tells overflow from underflow for a number too large or too small for a double */
+    static bool IsDecimalExponentPositive(const std::string_view Text)
+    {
+        std::int64_t IntegerDigits = 0;
+        std::size_t Index = Text[0] == '-' ? 1 : 0;
+
+        // Leading zeros don't contribute to the magnitude
+        while(Index < Text.size() && Text[Index] == '0'){
+            ++Index;
+        }
+
+        while(Index < Text.size() && Text[Index] >= '0' && Text[Index] <= '9'){
+            ++IntegerDigits;
+            ++Index;
+        }
+
+        std::int64_t Exponent = 0;
+        const std::size_t ExponentStart = Text.find_first_of("eE");
+
+        if(ExponentStart != std::string_view::npos){
+            std::size_t DigitStart = ExponentStart + 1;
+            const bool bNegative = Text[DigitStart] == '-';
+
+            if(Text[DigitStart] == '-' || Text[DigitStart] == '+'){
+                ++DigitStart;
+            }
+
+            for(std::size_t i = DigitStart; i < Text.size() && Exponent < 100000; ++i){
+                Exponent = Exponent * 10 + (Text[i] - '0');
+            }
+
+            Exponent = bNegative ? -Exponent : Exponent;
+        }
+
+        return IntegerDigits + Exponent > 0;
     }
 
     bool ParseWhiteSpace()
     {
-        while(!Stream->eof()){
-            CharType Char;
-            if(!Serialize(&Char, sizeof(CharType))){
-                return false;
+        CharType Char;
+
+        if constexpr (std::is_same_v<CharType, char>){
+            if(bIndexed){
+                // Only whitespace lies between the cursor and the next indexed position
+                Cursor = NextStructural < StructuralIndex.size() ? IndexBase + StructuralIndex[NextStructural] : IndexEnd;
+                return true;
             }
+
+            while(PeekChar(Char) && IsWhitespace(Char)){
+                std::uint32_t LineBreaks = 0;
+                const char* LastLineBreak = nullptr;
+                const char* RunEnd = JsonScanner::SkipWhitespace(Cursor, BufferEnd, LineBreaks, LastLineBreak);
+
+                if(LineBreaks){
+                    LineNumber += LineBreaks;
+                    CharacterNumber = static_cast<std::uint32_t>(RunEnd - LastLineBreak - 1);
+                }else{
+                    CharacterNumber += static_cast<std::uint32_t>(RunEnd - Cursor);
+                }
+
+                Cursor = RunEnd;
+            }
+
+            return !Source->HasError();
+        }
+
+        while(PeekChar(Char) && IsWhitespace(Char)){
+            ++Cursor;
             ++CharacterNumber;
 
             if(IsLineBreak(Char)){
                 ++LineNumber;
                 CharacterNumber = 0;
             }
-
-            if(!IsWhitespace(Char)){
-                // backtrack and break
-                Stream->seekg(Stream->tellg() - sizeof(CharType));
-                --CharacterNumber;
-                break;
-            }
         }
 
-        return true;
+        return !Source->HasError();
     }
 
     static bool IsLineBreak(const CharType& Char)
@@ -725,14 +1452,35 @@ private:
 
     static bool IsWhitespace(const CharType& Char)
     {
-        return Char == CharType(' ') || Char == CharType('\t') || 
+        return Char == CharType(' ') || Char == CharType('\t') ||
             Char == CharType('\n') || Char == CharType('\r');
     }
 
+    /** Quote, bracket, brace, colon or comma: anything a number or literal may be directly followed by besides whitespace */
+    static bool IsTokenBoundary(const CharType& Char)
+    {
+        return Char == CharType('\"') || Char == CharType('{') || Char == CharType('}') ||
+            Char == CharType('[') || Char == CharType(']') || Char == CharType(':') || Char == CharType(',');
+    }
+
+    /** Quote, bracket or line break: anything skipping has to look at outside of strings */
+    static bool IsStructural(const CharType& Char)
+    {
+        return Char == CharType('\"') || Char == CharType('{') || Char == CharType('}') ||
+            Char == CharType('[') || Char == CharType(']') || Char == CharType('\n');
+    }
+
+    /** Quote, backslash or control character: anything that ends a plain run inside a string */
+    static bool IsStringSpecial(const CharType& Char)
+    {
+        return Char == CharType('\"') || Char == CharType('\\') ||
+            static_cast<std::make_unsigned_t<CharType>>(Char) < 0x20;
+    }
+
     static bool IsJsonNumber(const CharType& Char)
     {
         return (Char >= CharType('0') && Char <= CharType('9')) ||
-            Char == CharType('-') || Char == CharType('.') || Char == CharType('+') || 
+            Char == CharType('-') || Char == CharType('.') || Char == CharType('+') ||
             Char == CharType('e') || Char == CharType('E');
     }
 
@@ -748,7 +1496,7 @@ private:
 
     static bool IsAlphaNumber(const CharType& Char)
     {
-        return (Char >= CharType('a') && Char <= CharType('z')) || 
+        return (Char >= CharType('a') && Char <= CharType('z')) ||
                (Char >= CharType('A') && Char <= CharType('Z'));
     }
 
@@ -760,12 +1508,12 @@ class JsonStringReader : public JsonReader<char>
 public:
     static std::shared_ptr<JsonStringReader> Create(const std::string& JsonString)
     {
-        return std::make_shared<JsonStringReader>(JsonString);
+        return std::shared_ptr<JsonStringReader>(new JsonStringReader(JsonString));
     }
 
     static std::shared_ptr<JsonStringReader> Create(std::string&& JsonString)
     {
-        return std::make_shared<JsonStringReader>(std::move(JsonString));
+        return std::shared_ptr<JsonStringReader>(new JsonStringReader(std::move(JsonString)));
     }
 
     const std::string& GetSourceString() const
@@ -779,22 +1527,22 @@ protected:
 
     /**
      * Parses a string containing Json information.
-     * 
+     *
      * @param JsonString The Json string to parse.
     */
     JsonStringReader(const std::string& JsonString) :
-        Content(JsonString), Reader(nullptr)
+        Content(JsonString)
     {
         InitReader();
     }
 
     /**
      * Parses a string containing Json information.
-     * 
+     *
      * @param JsonString The Json string to parse.
     */
     JsonStringReader(std::string&& JsonString) :
-        Content(std::move(JsonString)), Reader(nullptr)
+        Content(std::move(JsonString))
     {
         InitReader();
     }
@@ -805,14 +1553,103 @@ protected:
             return;
         }
 
-        Reader = std::make_unique<std::istringstream>(Content);
-        
-        Stream = std::make_unique<std::istream>(Reader.get());
+        Source = std::make_unique<JsonMemoryInputSource<char>>(Content.data(), Content.size());
     }
 
 protected:
     const std::string Content;
-    std::unique_ptr<std::istringstream> Reader;
+};
+
+
+/**
+ * Parses Json directly out of caller-owned memory, without copying it.
+ * 
+ * The memory must stay alive and unchanged for as long as the reader, and as
+ * long as any view obtained from it, is in use.
+*/
+class JsonStringViewReader : public JsonReader<char>
+{
+public:
+    static std::shared_ptr<JsonStringViewReader> Create(const std::string_view JsonString)
+    {
+        return std::shared_ptr<JsonStringViewReader>(new JsonStringViewReader(JsonString));
+    }
+
+    static std::shared_ptr<JsonStringViewReader> Create(const char* const Data, const std::size_t Length)
+    {
+        return Create(std::string_view(Data, Length));
+    }
+
+    std::string_view GetSourceString() const
+    {
+        return Content;
+    }
+
+    virtual ~JsonStringViewReader() = default;
+
+protected:
+
+    /**
+     * Parses a string containing Json information.
+     *
+     * @param JsonString The Json string to parse.
+    */
+    JsonStringViewReader(const std::string_view JsonString) :
+        Content(JsonString)
+    {
+        Source = std::make_unique<JsonMemoryInputSource<char>>(Content.data(), Content.size());
+    }
+
+protected:
+    const std::string_view Content;
+};
+
+
+/**
+ * Parses a Json file by mapping it into memory read-only.
+ * 
+ * The file is never copied onto the heap and pages are only faulted in as the
+ * tokenizer reaches them. Strings without escapes are returned as views into
+ * the mapping.
+*/
+class JsonFileReader : public JsonReader<char>
+{
+public:
+    static std::shared_ptr<JsonFileReader> Create(const std::string& FilePath)
+    {
+        return std::shared_ptr<JsonFileReader>(new JsonFileReader(FilePath));
+    }
+
+    const std::string& GetFilePath() const
+    {
+        return FilePath;
+    }
+
+    std::string_view GetSourceString() const
+    {
+        return std::string_view(MappedData, MappedSize);
+    }
+
+    virtual ~JsonFileReader();
+
+protected:
+
+    /**
+     * Opens and maps a file containing Json information.
+     * 
+     * Failing to open or map the file is reported through GetErrorMessage().
+     *
+     * @param InFilePath Path of the file to parse.
+    */
+    JsonFileReader(const std::string& InFilePath);
+
+protected:
+    const std::string FilePath;
+    const char* MappedData;
+    std::size_t MappedSize;
+
+    /** File contents on platforms without memory mapping */
+    std::string FallbackContent;
 };
 
 
@@ -825,15 +1662,32 @@ public:
         return JsonStringReader::Create(JsonString);
     }
 
-    static std::shared_ptr<JsonReater<char>> Create(std::string&& JsonString)
+    static std::shared_ptr<JsonReader<char>> Create(std::string&& JsonString)
     {
         return JsonStringReader::Create(std::move(JsonString));
     }
 
+    /** Creates a reader over caller-owned memory, which must outlive the reader. */
+    static std::shared_ptr<JsonReader<char>> CreateFromView(const std::string_view JsonString)
+    {
+        return JsonStringViewReader::Create(JsonString);
+    }
+
+    /** Creates a reader over a memory-mapped file. */
+    static std::shared_ptr<JsonReader<char>> CreateFromFile(const std::string& FilePath)
+    {
+        return JsonFileReader::Create(FilePath);
+    }
+
     static std::shared_ptr<JsonReader<CharType>> Create(std::istream* const Stream)
     {
         return JsonReader<CharType>::Create(Stream);
     }
+
+    static std::shared_ptr<JsonReader<CharType>> Create(std::unique_ptr<JsonInputSource<CharType>> Source)
+    {
+        return JsonReader<CharType>::Create(std::move(Source));
+    }
 };
 
-} // namespace zexjson
\ No newline at end of file
+} // namespace zexjson
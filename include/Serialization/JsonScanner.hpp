@@ -0,0 +1,113 @@
+#pragma once
+
+#include "Minimal.hpp"
+
+
+namespace zexjson{
+
+/** Instruction set used by the vectorized scanning routines. */
+enum class EJsonSimdLevel
+{
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+/** Progress of skipping over an object or array, carried between calls to JsonScanner::SkipContainerBlocks */
+struct JsonSkipState
+{
+    /** Brackets opened inside the skipped container and not closed yet */
+    std::uint32_t Depth = 0;
+
+    bool bInString = false;
+
+    /** Whether the next character is escaped by a backslash */
+    bool bEscaped = false;
+
+    /** Set once the closing bracket of the skipped container is found */
+    bool bClosed = false;
+
+    /** Line breaks skipped by the last call, and the last of them */
+    std::uint32_t LineBreaks = 0;
+    const char* LastLineBreak = nullptr;
+};
+
+namespace JsonScanner{
+
+/**
+ * Finds the first character that ends a plain run inside a Json string.
+ * 
+ * @param Begin First character to look at.
+ * @param End One past the last character to look at.
+ * @return The first quote, backslash or control character, or @c End if there is none.
+*/
+const char* FindStringSpecial(const char* Begin, const char* End);
+
+/**
+ * Skips a run of Json whitespace.
+ * 
+ * @param Begin First character to look at.
+ * @param End One past the last character to look at.
+ * @param OutLineBreaks Receives the number of line breaks skipped.
+ * @param OutLastLineBreak Receives the last line break skipped, left untouched if there was none.
+ * @return The first non-whitespace character, or @c End if there is none.
+*/
+const char* SkipWhitespace(const char* Begin, const char* End, std::uint32_t& OutLineBreaks, const char*& OutLastLineBreak);
+
+/**
+ * Finds the next character that matters when skipping over Json outside of strings.
+ * 
+ * @param Begin First character to look at.
+ * @param End One past the last character to look at.
+ * @return The first quote, bracket, brace or line break, or @c End if there is none.
+*/
+const char* FindStructural(const char* Begin, const char* End);
+
+/**
+ * Skips over the contents of an object or array 64 bytes at a time.
+ * 
+ * Each block is classified with vector compares into bit masks of quotes,
+ * backslashes and brackets; escapes and string interiors are resolved with
+ * carries across blocks, so only brackets outside of strings change the depth.
+ * Stops early at a block holding a control character inside a string, which
+ * the caller has to look at one character at a time, and before the last
+ * partial block.
+ * 
+ * @param Begin First character to look at.
+ * @param End One past the last character to look at.
+ * @param State Progress so far, updated as blocks are skipped.
+ * @return The closing bracket of the container if State.bClosed is set, otherwise where skipping stopped.
+*/
+const char* SkipContainerBlocks(const char* Begin, const char* End, JsonSkipState& State);
+
+/**
+ * Builds the structural index of a whole input, the first stage of the indexed reader.
+ *
+ * Records the offset of every character the tokenizer has to stop at:
+ * brackets, braces, colons and commas outside of strings, the opening quote
+ * of every string, and the first character of every other token. Each
+ * 64-byte block is classified with vector compares; escapes and string
+ * interiors are resolved with the same carries as SkipContainerBlocks(), so
+ * no offset points into a string.
+ *
+ * @param Begin First character of the input.
+ * @param End One past the last character. The input must be shorter than 4 GiB.
+ * @param OutIndex Receives the offsets from Begin in increasing order, replacing its contents.
+*/
+void BuildStructuralIndex(const char* Begin, const char* End, std::vector<std::uint32_t>& OutIndex);
+
+/** Returns the instruction set selected for this CPU. */
+EJsonSimdLevel GetSimdLevel();
+
+/**
+ * Forces the scanner down to the given instruction set, e.g. for benchmarking.
+ * Requests above what the CPU supports are clamped.
+ *
+ * Safe to call while other threads are reading: every level finds the same
+ * characters, so reads in progress go on at the new level.
+*/
+void SetSimdLevel(EJsonSimdLevel Level);
+
+} // namespace JsonScanner
+
+} // namespace zexjson
@@ -0,0 +1,938 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "Domain/JsonValue.hpp"
+#include "Domain/JsonObject.hpp"
+#include "Domain/JsonDocument.hpp"
+#include "Domain/JsonCompactValue.hpp"
+#include "Domain/JsonLazyValue.hpp"
+#include "Domain/JsonPointer.hpp"
+#include "Domain/JsonProjection.hpp"
+#include "Serialization/JsonReader.hpp"
+#include "Serialization/JsonWriter.hpp"
+
+
+namespace zexjson{
+
+/** Builds JsonValue/JsonObject trees out of the token stream of a JsonReader, and writes them back out. */
+class JsonSerializer
+{
+public:
+    /** Convenience overload for readers held by shared pointer, e.g. from JsonReaderFactory. */
+    template<class ReaderType, class OutType>
+    static bool Deserialize(const std::shared_ptr<ReaderType>& Reader, OutType& Out)
+    {
+        return Reader && Deserialize(*Reader, Out);
+    }
+
+    /**
+     * Reads a whole document into a tree.
+     *
+     * @param Reader The reader to pull tokens from.
+     * @param OutValue Receives the root value, either an object or an array.
+     * @return @c true on success, @c false if the reader reported an error.
+    */
+    template<class CharType>
+    static bool Deserialize(JsonReader<CharType>& Reader, std::shared_ptr<JsonValue>& OutValue)
+    {
+        EJson RootType;
+        std::shared_ptr<JsonObject> Object;
+        JsonArray Array;
+
+        if(!DeserializeRoot(Reader, RootType, Object, Array, HeapNodeFactory()) || !ReadDocumentEnd(Reader)){
+            return false;
+        }
+
+        if(RootType == EJson::Object){
+            OutValue = std::make_shared<JsonValueObject>(std::move(Object));
+        }else{
+            OutValue = std::make_shared<JsonValueArray>(std::move(Array));
+        }
+
+        return true;
+    }
+
+    /**
+     * Reads a document whose root is an object.
+     *
+     * @param Reader The reader to pull tokens from.
+     * @param OutObject Receives the root object.
+     * @return @c true on success, @c false if the reader reported an error or the root is not an object.
+    */
+    template<class CharType>
+    static bool Deserialize(JsonReader<CharType>& Reader, std::shared_ptr<JsonObject>& OutObject)
+    {
+        EJson RootType;
+        std::shared_ptr<JsonObject> Object;
+        JsonArray Array;
+
+        if(!DeserializeRoot(Reader, RootType, Object, Array, HeapNodeFactory()) || !ReadDocumentEnd(Reader) || RootType != EJson::Object){
+            return false;
+        }
+
+        OutObject = std::move(Object);
+        return true;
+    }
+
+    /**
+     * Reads a document whose root is an array.
+     *
+     * @param Reader The reader to pull tokens from.
+     * @param OutArray Receives the elements of the root array.
+     * @return @c true on success, @c false if the reader reported an error or the root is not an array.
+    */
+    template<class CharType>
+    static bool Deserialize(JsonReader<CharType>& Reader, JsonArray& OutArray)
+    {
+        EJson RootType;
+        std::shared_ptr<JsonObject> Object;
+        JsonArray Array;
+
+        if(!DeserializeRoot(Reader, RootType, Object, Array, HeapNodeFactory()) || !ReadDocumentEnd(Reader) || RootType != EJson::Array){
+            return false;
+        }
+
+        OutArray = std::move(Array);
+        return true;
+    }
+
+    /**
+     * Reads a whole document into the arena of a JsonDocument.
+     *
+     * @param Reader The reader to pull tokens from.
+     * @param OutDocument Receives the root value; nodes, strings, names and tables are all allocated in its arena.
+     * @return @c true on success, @c false if the reader reported an error.
+    */
+    template<class CharType>
+    static bool Deserialize(JsonReader<CharType>& Reader, JsonDocument& OutDocument)
+    {
+        EJson RootType;
+        std::shared_ptr<JsonObject> Object;
+        JsonArray Array(OutDocument.GetResource());
+
+        if(!DeserializeRoot(Reader, RootType, Object, Array, OutDocument) || !ReadDocumentEnd(Reader)){
+            return false;
+        }
+
+        if(RootType == EJson::Object){
+            OutDocument.SetRoot(OutDocument.MakeShared<JsonValueObject>(std::move(Object)));
+        }else{
+            OutDocument.SetRoot(OutDocument.MakeShared<JsonValueArray>(std::move(Array)));
+        }
+
+        return true;
+    }
+
+    /**
+     * Reads newline-delimited Json (NDJSON, JSON Lines): one root object or array per line.
+     *
+     * Switches the reader to line-delimited mode, see JsonReader::SetLineDelimited().
+     *
+     * @param Reader The reader to pull tokens from.
+     * @param OnRecord Called with each record in order as bool(std::shared_ptr<JsonValue>); return false to stop reading.
+     * @return @c true if every record was read or reading was stopped, @c false if the reader reported an error.
+    */
+    template<class CharType, class CallbackType>
+    static bool DeserializeLines(JsonReader<CharType>& Reader, CallbackType&& OnRecord)
+    {
+        Reader.SetLineDelimited(true);
+
+        std::shared_ptr<JsonValue> Record;
+
+        while(Deserialize(Reader, Record)){
+            if(!OnRecord(std::move(Record))){
+                return true;
+            }
+        }
+
+        return Reader.GetErrorMessage().empty();
+    }
+
+    /**
+     * Sets a document up for on-demand access instead of building the whole tree.
+     *
+     * Objects and arrays are parsed the first time they are accessed, see
+     * JsonValueLazy; subtrees that are never accessed are only skipped over.
+     *
+     * @param Reader A fresh reader over text held in memory: a JsonStringReader,
+     *        JsonStringViewReader or JsonFileReader. The lazy tree keeps it alive.
+     * @param OutValue Receives the root value, either an object or an array.
+     * @return @c true on success, @c false if the reader failed or the text doesn't start with an object or array.
+    */
+    template<class ReaderType>
+    static bool DeserializeLazy(const std::shared_ptr<ReaderType>& Reader, std::shared_ptr<JsonValue>& OutValue)
+    {
+        if(!Reader || !Reader->GetErrorMessage().empty()){
+            return false;
+        }
+
+        std::shared_ptr<JsonValue> Root = JsonValueLazy::Create(Reader->GetSourceString(), Reader);
+
+        if(!Root){
+            return false;
+        }
+
+        OutValue = std::move(Root);
+        return true;
+    }
+
+    /**
+     * Reads a whole document into a compact value tree.
+     *
+     * @param Reader The reader to pull tokens from.
+     * @param OutValue Receives the root value, either an object or an array.
+     * @return @c true on success, @c false if the reader reported an error.
+    */
+    template<class CharType>
+    static bool Deserialize(JsonReader<CharType>& Reader, JsonCompactValue& OutValue)
+    {
+        struct StackFrame
+        {
+            EJson Type;
+            std::string Identifier;
+            JsonCompactValue::ArrayType Array;
+            JsonCompactValue::ObjectType Object;
+            CompactNameIndex NameIndex;
+        };
+
+        std::vector<StackFrame> Stack;
+        std::vector<std::size_t> SizeHints;
+
+        EJsonNotation Notation;
+
+        while(Reader.ReadNext(Notation)){
+            std::string Identifier = Reader.MoveIdentifier();
+            JsonCompactValue NewValue;
+
+            switch (Notation)
+            {
+            case EJsonNotation::ObjectStart:
+            case EJsonNotation::ArrayStart:
+            {
+                const std::size_t Depth = Stack.size();
+                if(SizeHints.size() <= Depth){
+                    SizeHints.push_back(0);
+                }
+
+                StackFrame& Frame = Stack.emplace_back();
+                Frame.Identifier = std::move(Identifier);
+
+                if(Notation == EJsonNotation::ObjectStart){
+                    Frame.Type = EJson::Object;
+                    Frame.Object.reserve(SizeHints[Depth]);
+                }else{
+                    Frame.Type = EJson::Array;
+                    Frame.Array.reserve(SizeHints[Depth]);
+                }
+
+                continue;
+            }
+
+            case EJsonNotation::ObjectEnd:
+            case EJsonNotation::ArrayEnd:
+            {
+                if(Stack.empty()){
+                    return false;
+                }
+
+                StackFrame& Frame = Stack.back();
+
+                if(Frame.Type == EJson::Object){
+                    SizeHints[Stack.size() - 1] = Frame.Object.size();
+                    NewValue = JsonCompactValue(std::move(Frame.Object));
+                }else{
+                    SizeHints[Stack.size() - 1] = Frame.Array.size();
+                    NewValue = JsonCompactValue(std::move(Frame.Array));
+                }
+
+                if(Stack.size() == 1){
+                    if(!ReadDocumentEnd(Reader)){
+                        return false;
+                    }
+
+                    OutValue = std::move(NewValue);
+                    return true;
+                }
+
+                Identifier = std::move(Frame.Identifier);
+                Stack.pop_back();
+                break;
+            }
+
+            case EJsonNotation::String:
+                NewValue = JsonCompactValue(Reader.GetValueAsStringView());
+                break;
+
+            case EJsonNotation::Number:
+                switch (Reader.GetValueNumberType())
+                {
+                case EJsonNumber::Int64:
+                    NewValue = JsonCompactValue(Reader.GetValueAsInt64());
+                    break;
+
+                case EJsonNumber::UInt64:
+                    NewValue = JsonCompactValue(Reader.GetValueAsUInt64());
+                    break;
+
+                default:
+                    NewValue = JsonCompactValue(Reader.GetValueAsNumber());
+                    break;
+                }
+                break;
+
+            case EJsonNotation::Boolean:
+                NewValue = JsonCompactValue(Reader.GetValueAsBoolean());
+                break;
+
+            case EJsonNotation::Null:
+                NewValue = JsonCompactValue(nullptr);
+                break;
+
+            case EJsonNotation::Error:
+                return false;
+            }
+
+            if(Stack.empty()){
+                return false;
+            }
+
+            StackFrame& Parent = Stack.back();
+
+            if(Parent.Type == EJson::Object){
+                AddCompactMember(Parent.Object, Parent.NameIndex, std::move(Identifier), std::move(NewValue));
+            }else{
+                Parent.Array.push_back(std::move(NewValue));
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Evaluates a Json Pointer over the token stream of a reader, without building the document.
+     *
+     * Members and elements that can't lead to a match are skipped with
+     * SkipObject()/SkipArray(); only matched values are built. Once a segment
+     * without wildcards has matched, the rest of its container is skipped, so
+     * for duplicate member names the first one counts.
+     *
+     * @param Reader A fresh reader to pull tokens from.
+     * @param Pointer The pointer to evaluate.
+     * @param OnMatch Called with each match in document order as bool(std::shared_ptr<JsonValue>); return false to stop reading.
+     * @return @c true on success, @c false if the pointer is invalid or the reader reported an error.
+    */
+    template<class CharType, class CallbackType>
+    static bool Select(JsonReader<CharType>& Reader, const JsonPointer& Pointer, CallbackType&& OnMatch)
+    {
+        if(!Pointer.IsValid()){
+            return false;
+        }
+
+        EJsonNotation Notation;
+
+        if(!Reader.ReadNext(Notation) || (Notation != EJsonNotation::ObjectStart && Notation != EJsonNotation::ArrayStart)){
+            return false;
+        }
+
+        if(Pointer.GetSegmentCount() == 0){
+            std::shared_ptr<JsonValue> Match;
+            return MakeValue(Reader, Notation, Match) && (OnMatch(std::move(Match)), true);
+        }
+
+        bool bStopped = false;
+        return SelectIn(Reader, Pointer, 0, Notation == EJsonNotation::ObjectStart, OnMatch, bStopped);
+    }
+
+    /**
+     * Collects every value a Json Pointer matches, without building the document.
+     *
+     * @param Reader A fresh reader to pull tokens from.
+     * @param Pointer The pointer to evaluate.
+     * @param OutMatches Receives the matches in document order.
+     * @return @c true on success, @c false if the pointer is invalid or the reader reported an error.
+    */
+    template<class CharType>
+    static bool Select(JsonReader<CharType>& Reader, const JsonPointer& Pointer, std::vector<std::shared_ptr<JsonValue>>& OutMatches)
+    {
+        return Select(Reader, Pointer, [&OutMatches](std::shared_ptr<JsonValue> Match)
+        {
+            OutMatches.push_back(std::move(Match));
+            return true;
+        });
+    }
+
+    /**
+     * Extracts the first value a Json Pointer matches, reading no further than needed.
+     *
+     * @param Reader A fresh reader to pull tokens from.
+     * @param Pointer The pointer to evaluate.
+     * @param OutMatch Receives the match.
+     * @return @c true if a value was found, @c false if there is none or reading failed.
+    */
+    template<class CharType>
+    static bool Select(JsonReader<CharType>& Reader, const JsonPointer& Pointer, std::shared_ptr<JsonValue>& OutMatch)
+    {
+        std::shared_ptr<JsonValue> Match;
+
+        const bool bSuccess = Select(Reader, Pointer, [&Match](std::shared_ptr<JsonValue> Value)
+        {
+            Match = std::move(Value);
+            return false;
+        });
+
+        if(!bSuccess || !Match){
+            return false;
+        }
+
+        OutMatch = std::move(Match);
+        return true;
+    }
+
+    /**
+     * Extracts every path of a projection in one pass over the token stream of a reader.
+     *
+     * Each member is looked up once in the projection's automaton; members no
+     * path leads into are skipped with SkipObject()/SkipArray(), and only
+     * captured values are built. A path without wildcards takes its first
+     * match, and reading stops as soon as every path is satisfied.
+     *
+     * @param Reader A fresh reader to pull tokens from.
+     * @param Projection The paths to extract.
+     * @param OutResult Receives the matches, reset first.
+     * @return @c true on success, @c false if the projection is invalid or the reader reported an error.
+    */
+    template<class CharType>
+    static bool Project(JsonReader<CharType>& Reader, const JsonProjection& Projection, JsonProjectionResult& OutResult)
+    {
+        OutResult.Reset(Projection);
+
+        if(!Projection.IsValid()){
+            return false;
+        }
+
+        EJsonNotation Notation;
+
+        if(!Reader.ReadNext(Notation) || (Notation != EJsonNotation::ObjectStart && Notation != EJsonNotation::ArrayStart)){
+            return false;
+        }
+
+        return ProjectValue(Reader, Projection, JsonProjection::RootState, Notation, OutResult);
+    }
+
+    /** Convenience overload for writers held by shared pointer, e.g. from JsonWriterFactory. */
+    template<class InType, class PrintPolicy>
+    static bool Serialize(const InType& In, const std::shared_ptr<JsonWriter<PrintPolicy>>& Writer)
+    {
+        return Writer && Serialize(In, *Writer);
+    }
+
+    /**
+     * Writes a value and closes the writer.
+     *
+     * @param Value The value to write.
+     * @param Writer The writer to write with.
+     * @return @c true on success, @c false if the value is null or the output failed.
+    */
+    template<class PrintPolicy>
+    static bool Serialize(const std::shared_ptr<JsonValue>& Value, JsonWriter<PrintPolicy>& Writer)
+    {
+        if(!Value){
+            return false;
+        }
+
+        Writer.Write(*Value);
+        return Writer.Close();
+    }
+
+    /**
+     * Writes an object and closes the writer.
+     *
+     * @param Object The object to write.
+     * @param Writer The writer to write with.
+     * @return @c true on success, @c false if the object is null or the output failed.
+    */
+    template<class PrintPolicy>
+    static bool Serialize(const std::shared_ptr<JsonObject>& Object, JsonWriter<PrintPolicy>& Writer)
+    {
+        if(!Object){
+            return false;
+        }
+
+        Writer.Write(*Object);
+        return Writer.Close();
+    }
+
+    /**
+     * Writes an array and closes the writer.
+     *
+     * @param Array The elements of the array to write.
+     * @param Writer The writer to write with.
+     * @return @c true on success, @c false if the output failed.
+    */
+    template<class PrintPolicy>
+    static bool Serialize(const JsonArray& Array, JsonWriter<PrintPolicy>& Writer)
+    {
+        Writer.Write(Array);
+        return Writer.Close();
+    }
+
+    /**
+     * Writes a compact value and closes the writer.
+     *
+     * @param Value The value to write.
+     * @param Writer The writer to write with.
+     * @return @c true on success, @c false if the output failed.
+    */
+    template<class PrintPolicy>
+    static bool Serialize(const JsonCompactValue& Value, JsonWriter<PrintPolicy>& Writer)
+    {
+        Writer.Write(Value);
+        return Writer.Close();
+    }
+
+    /**
+     * Writes a frozen value and closes the writer.
+     *
+     * @param Value The value to write, e.g. JsonFrozenDocument::GetRoot().
+     * @param Writer The writer to write with.
+     * @return @c true on success, @c false if the output failed.
+    */
+    template<class PrintPolicy>
+    static bool Serialize(const JsonFrozenValue& Value, JsonWriter<PrintPolicy>& Writer)
+    {
+        Writer.Write(Value);
+        return Writer.Close();
+    }
+
+protected:
+    /**
+     * Checks that nothing but white space follows the root the reader has just closed.
+     *
+     * Line-delimited readers are left alone, as the next record may follow.
+    */
+    template<class CharType>
+    static bool ReadDocumentEnd(JsonReader<CharType>& Reader)
+    {
+        if(Reader.IsLineDelimited()){
+            return true;
+        }
+
+        EJsonNotation Notation;
+        Reader.ReadNext(Notation);
+
+        return Reader.GetErrorMessage().empty();
+    }
+
+    /** Allocates every node on its own with std::make_shared, and their contents on the heap */
+    struct HeapNodeFactory
+    {
+        std::pmr::memory_resource* GetResource() const
+        {
+            return std::pmr::get_default_resource();
+        }
+
+        template<class T, class... ArgTypes>
+        std::shared_ptr<T> MakeShared(ArgTypes&&... Args) const
+        {
+            return std::make_shared<T>(std::forward<ArgTypes>(Args)...);
+        }
+
+        JsonName MakeName(const std::string_view Name) const
+        {
+            return JsonName(Name);
+        }
+    };
+
+    /**
+     * Builds the root container the reader is about to produce.
+     *
+     * Strings and field names are made straight from the reader's views, so
+     * text read in place is copied once, into the node. Containers are closed
+     * without recursion, so arbitrarily deep documents don't grow the call
+     * stack. Nodes and names are made through Factory, and strings, arrays and
+     * field tables are kept in its memory resource; OutArray must use the
+     * same one, so the root's elements are handed over without a copy.
+     * If Started is ObjectStart or ArrayStart, the reader has just returned it
+     * and the container it opens is built instead.
+    */
+    template<class CharType, class NodeFactory>
+    static bool DeserializeRoot(JsonReader<CharType>& Reader, EJson& OutType, std::shared_ptr<JsonObject>& OutObject, JsonArray& OutArray, const NodeFactory& Factory, const EJsonNotation Started = EJsonNotation::Error)
+    {
+        struct StackFrame
+        {
+            EJson Type;
+            JsonName Identifier;
+            JsonArray Array;
+            std::shared_ptr<JsonObject> Object;
+        };
+
+        std::pmr::memory_resource* const Resource = Factory.GetResource();
+
+        std::vector<StackFrame> Stack;
+
+        // Size of the last container completed at each depth. Sibling records in
+        // an array tend to have the same shape, so this makes a good reservation.
+        std::vector<std::size_t> SizeHints;
+
+        EJsonNotation Notation = Started;
+        bool bStarted = Started == EJsonNotation::ObjectStart || Started == EJsonNotation::ArrayStart;
+
+        while(std::exchange(bStarted, false) || Reader.ReadNext(Notation)){
+            JsonName Identifier = Factory.MakeName(Reader.GetIdentifierView());
+            std::shared_ptr<JsonValue> NewValue;
+
+            switch (Notation)
+            {
+            case EJsonNotation::ObjectStart:
+            case EJsonNotation::ArrayStart:
+            {
+                const std::size_t Depth = Stack.size();
+                if(SizeHints.size() <= Depth){
+                    SizeHints.push_back(0);
+                }
+
+                StackFrame& Frame = Stack.emplace_back(StackFrame{EJson::Array, std::move(Identifier), JsonArray(Resource), nullptr});
+
+                if(Notation == EJsonNotation::ObjectStart){
+                    Frame.Type = EJson::Object;
+                    Frame.Object = Factory.template MakeShared<JsonObject>(Resource);
+                    Frame.Object->Values.reserve(SizeHints[Depth]);
+                }else{
+                    Frame.Array.reserve(SizeHints[Depth]);
+                }
+
+                continue;
+            }
+
+            case EJsonNotation::ObjectEnd:
+            case EJsonNotation::ArrayEnd:
+            {
+                if(Stack.empty()){
+                    return false;
+                }
+
+                StackFrame& Frame = Stack.back();
+
+                if(Stack.size() == 1){
+                    OutType = Frame.Type;
+                    OutObject = std::move(Frame.Object);
+                    OutArray = std::move(Frame.Array);
+                    return true;
+                }
+
+                Identifier = std::move(Frame.Identifier);
+
+                if(Frame.Type == EJson::Object){
+                    SizeHints[Stack.size() - 1] = Frame.Object->Values.size();
+                    NewValue = Factory.template MakeShared<JsonValueObject>(std::move(Frame.Object));
+                }else{
+                    SizeHints[Stack.size() - 1] = Frame.Array.size();
+                    NewValue = Factory.template MakeShared<JsonValueArray>(std::move(Frame.Array));
+                }
+
+                Stack.pop_back();
+                break;
+            }
+
+            case EJsonNotation::String:
+                NewValue = Factory.template MakeShared<JsonValueString>(Reader.GetValueAsStringView(), Resource);
+                break;
+
+            case EJsonNotation::Number:
+                NewValue = MakeNumber(Reader, Factory);
+                break;
+
+            case EJsonNotation::Boolean:
+                NewValue = Factory.template MakeShared<JsonValueBoolean>(Reader.GetValueAsBoolean());
+                break;
+
+            case EJsonNotation::Null:
+                NewValue = Factory.template MakeShared<JsonValueNull>();
+                break;
+
+            case EJsonNotation::Error:
+                return false;
+            }
+
+            if(Stack.empty()){
+                return false;
+            }
+
+            StackFrame& Parent = Stack.back();
+
+            if(Parent.Type == EJson::Object){
+                Parent.Object->Values.insert_or_assign(std::move(Identifier), std::move(NewValue));
+            }else{
+                Parent.Array.push_back(std::move(NewValue));
+            }
+        }
+
+        return false;
+    }
+
+    /** Builds the value the reader has just returned, a whole container if it opened one */
+    template<class CharType>
+    static bool MakeValue(JsonReader<CharType>& Reader, const EJsonNotation Notation, std::shared_ptr<JsonValue>& OutValue)
+    {
+        const HeapNodeFactory Factory;
+
+        switch (Notation)
+        {
+        case EJsonNotation::ObjectStart:
+        case EJsonNotation::ArrayStart:
+        {
+            EJson Type;
+            std::shared_ptr<JsonObject> Object;
+            JsonArray Array;
+
+            if(!DeserializeRoot(Reader, Type, Object, Array, Factory, Notation)){
+                return false;
+            }
+
+            if(Type == EJson::Object){
+                OutValue = std::make_shared<JsonValueObject>(std::move(Object));
+            }else{
+                OutValue = std::make_shared<JsonValueArray>(std::move(Array));
+            }
+
+            return true;
+        }
+
+        case EJsonNotation::String:
+            OutValue = std::make_shared<JsonValueString>(Reader.GetValueAsStringView());
+            return true;
+
+        case EJsonNotation::Number:
+            OutValue = MakeNumber(Reader, Factory);
+            return true;
+
+        case EJsonNotation::Boolean:
+            OutValue = std::make_shared<JsonValueBoolean>(Reader.GetValueAsBoolean());
+            return true;
+
+        case EJsonNotation::Null:
+            OutValue = std::make_shared<JsonValueNull>();
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    /**
+     * Matches the members of the container the reader is in against the
+     * segment at Depth, descending into matching containers and skipping the
+     * rest. Returns with the reader past the container's end, or right after
+     * the match that made OnMatch return false.
+    */
+    template<class CharType, class CallbackType>
+    static bool SelectIn(JsonReader<CharType>& Reader, const JsonPointer& Pointer, const std::size_t Depth, const bool bInObject, CallbackType& OnMatch, bool& bStopped)
+    {
+        const JsonPointer::Segment& Segment = Pointer.GetSegment(Depth);
+        const bool bLast = Depth + 1 == Pointer.GetSegmentCount();
+
+        std::size_t Index = 0;
+        EJsonNotation Notation;
+
+        while(Reader.ReadNext(Notation)){
+            if(Notation == EJsonNotation::ObjectEnd || Notation == EJsonNotation::ArrayEnd){
+                return true;
+            }
+
+            if(Notation == EJsonNotation::Error){
+                return false;
+            }
+
+            const bool bObject = Notation == EJsonNotation::ObjectStart;
+            const bool bContainer = bObject || Notation == EJsonNotation::ArrayStart;
+            const bool bMatch = bInObject ? Segment.MatchesName(Reader.GetIdentifierView()) : Segment.MatchesIndex(Index++);
+
+            if(!bMatch){
+                if(bContainer && !(bObject ? Reader.SkipObject() : Reader.SkipArray())){
+                    return false;
+                }
+
+                continue;
+            }
+
+            if(bLast){
+                std::shared_ptr<JsonValue> Match;
+
+                if(!MakeValue(Reader, Notation, Match)){
+                    return false;
+                }
+
+                if(!OnMatch(std::move(Match))){
+                    bStopped = true;
+                    return true;
+                }
+            }else if(bContainer){
+                if(!SelectIn(Reader, Pointer, Depth + 1, bObject, OnMatch, bStopped)){
+                    return false;
+                }
+
+                if(bStopped){
+                    return true;
+                }
+            }
+
+            if(!Segment.bWildcard){
+                // Nothing else in this container can match
+                return bInObject ? Reader.SkipObject() : Reader.SkipArray();
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Handles the value the reader has just returned, which is in the given
+     * state: builds it if a path captures it, otherwise descends into it or
+     * skips it.
+    */
+    template<class CharType>
+    static bool ProjectValue(JsonReader<CharType>& Reader, const JsonProjection& Projection, const JsonProjection::StateIndex Index, const EJsonNotation Notation, JsonProjectionResult& OutResult)
+    {
+        const bool bObject = Notation == EJsonNotation::ObjectStart;
+        const bool bContainer = bObject || Notation == EJsonNotation::ArrayStart;
+
+        if(OutResult.Wants(Index)){
+            std::shared_ptr<JsonValue> Value;
+
+            if(!MakeValue(Reader, Notation, Value)){
+                return false;
+            }
+
+            // Paths continuing below the captured value are matched in the built tree
+            Projection.ProjectFrom(Index, Value, OutResult);
+            return true;
+        }
+
+        if(!bContainer){
+            return true;
+        }
+
+        if(OutResult.IsDone(Index) || !Projection.GetState(Index).HasTransitions()){
+            return bObject ? Reader.SkipObject() : Reader.SkipArray();
+        }
+
+        return ProjectIn(Reader, Projection, Index, bObject, OutResult);
+    }
+
+    /**
+     * Moves each member of the container the reader is in to its state,
+     * skipping those no path leads into. Returns with the reader past the
+     * container's end, or wherever reading stopped once the result is complete.
+    */
+    template<class CharType>
+    static bool ProjectIn(JsonReader<CharType>& Reader, const JsonProjection& Projection, const JsonProjection::StateIndex Index, const bool bInObject, JsonProjectionResult& OutResult)
+    {
+        std::size_t ElementIndex = 0;
+        EJsonNotation Notation;
+
+        while(Reader.ReadNext(Notation)){
+            if(Notation == EJsonNotation::ObjectEnd || Notation == EJsonNotation::ArrayEnd){
+                return true;
+            }
+
+            if(Notation == EJsonNotation::Error){
+                return false;
+            }
+
+            const JsonProjection::StateIndex Target = bInObject ? Projection.FindMember(Index, Reader.GetIdentifierView()) : Projection.FindElement(Index, ElementIndex++);
+
+            if(Target == JsonProjection::NoState || OutResult.IsDone(Target)){
+                if(Notation == EJsonNotation::ObjectStart && !Reader.SkipObject()){
+                    return false;
+                }
+
+                if(Notation == EJsonNotation::ArrayStart && !Reader.SkipArray()){
+                    return false;
+                }
+
+                continue;
+            }
+
+            if(!ProjectValue(Reader, Projection, Target, Notation, OutResult)){
+                return false;
+            }
+
+            if(OutResult.IsComplete()){
+                // Nothing after this can match, so leave the rest unread
+                return true;
+            }
+
+            if(OutResult.IsDone(Index)){
+                return bInObject ? Reader.SkipObject() : Reader.SkipArray();
+            }
+        }
+
+        return false;
+    }
+
+    /** Positions of the members of a compact object being built, by hash of their names */
+    using CompactNameIndex = std::unordered_multimap<std::size_t, std::size_t>;
+
+    /**
+     * Adds a member to a compact object being built.
+     *
+     * A later duplicate replaces the value of the earlier member in place, as
+     * it does for JsonObject. Objects past JsonFieldMap::IndexThreshold members
+     * are searched through NameIndex, which is built on first use.
+    */
+    static void AddCompactMember(JsonCompactValue::ObjectType& Object, CompactNameIndex& NameIndex, std::string&& Name, JsonCompactValue&& Value)
+    {
+        if(Object.size() <= JsonFieldMap::IndexThreshold){
+            for(auto& Member : Object){
+                if(Member.first == Name){
+                    Member.second = std::move(Value);
+                    return;
+                }
+            }
+
+            Object.emplace_back(std::move(Name), std::move(Value));
+            return;
+        }
+
+        const std::hash<std::string_view> Hasher;
+
+        if(NameIndex.empty()){
+            for(std::size_t i{0}; i < Object.size(); ++i){
+                NameIndex.emplace(Hasher(Object[i].first), i);
+            }
+        }
+
+        const std::size_t Hash = Hasher(Name);
+        const auto [First, Last] = NameIndex.equal_range(Hash);
+
+        for(auto It = First; It != Last; ++It){
+            auto& Member = Object[It->second];
+            if(Member.first == Name){
+                Member.second = std::move(Value);
+                return;
+            }
+        }
+
+        NameIndex.emplace(Hash, Object.size());
+        Object.emplace_back(std::move(Name), std::move(Value));
+    }
+
+    /** Creates a number value, keeping integers exact */
+    template<class CharType, class NodeFactory>
+    static std::shared_ptr<JsonValue> MakeNumber(const JsonReader<CharType>& Reader, const NodeFactory& Factory)
+    {
+        switch (Reader.GetValueNumberType())
+        {
+        case EJsonNumber::Int64:
+            return Factory.template MakeShared<JsonValueNumber>(Reader.GetValueAsInt64());
+
+        case EJsonNumber::UInt64:
+            return Factory.template MakeShared<JsonValueNumber>(Reader.GetValueAsUInt64());
+
+        default:
+            return Factory.template MakeShared<JsonValueNumber>(Reader.GetValueAsNumber());
+        }
+    }
+};
+
+} // namespace zexjson
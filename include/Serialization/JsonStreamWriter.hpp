@@ -0,0 +1,363 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "Serialization/JsonTypes.hpp"
+#include "Serialization/JsonOutputBuffer.hpp"
+#include "Serialization/JsonPrintPolicy.hpp"
+
+
+namespace zexjson{
+
+/**
+ * Writes Json one token at a time, for output that never exists as a tree.
+ *
+ * Calls mirror the notations produced by JsonReader: WriteObjectStart,
+ * WriteArrayStart, WriteValue and WriteNull with or without an identifier,
+ * WriteObjectEnd and WriteArrayEnd. Nesting is checked against a stack of the
+ * open containers; a call that would produce invalid Json fails, sets an
+ * error message and leaves the writer failed. Output reaches the target in
+ * fixed-size blocks, so memory use doesn't depend on the size of the document.
+ *
+ * @param PrintPolicy CondensedJsonPrintPolicy or PrettyJsonPrintPolicy.
+*/
+template<class PrintPolicy = CondensedJsonPrintPolicy>
+class JsonStreamWriter
+{
+public:
+    /**
+     * Creates a writer that outputs to a stream in blocks.
+     *
+     * @param OutStream The stream to write to, which must outlive the writer.
+     * @param BlockSize Size of the blocks handed to the stream.
+    */
+    static std::shared_ptr<JsonStreamWriter> Create(std::ostream* const OutStream, const std::size_t BlockSize = JsonOutputBuffer::DefaultBlockSize)
+    {
+        return std::shared_ptr<JsonStreamWriter>(new JsonStreamWriter(OutStream, BlockSize));
+    }
+
+    /**
+     * Creates a writer that hands its output to a function in blocks.
+     *
+     * @param Sink Called with each block of output.
+     * @param BlockSize Size of the blocks handed to the sink.
+    */
+    static std::shared_ptr<JsonStreamWriter> Create(JsonOutputBuffer::SinkFunction Sink, const std::size_t BlockSize = JsonOutputBuffer::DefaultBlockSize)
+    {
+        return std::shared_ptr<JsonStreamWriter>(new JsonStreamWriter(std::move(Sink), BlockSize));
+    }
+
+    /**
+     * Creates a writer that appends to a string.
+     *
+     * @param OutString The string to append to. Its contents are complete once Close() is called.
+    */
+    static std::shared_ptr<JsonStreamWriter> Create(std::string* const OutString)
+    {
+        return std::shared_ptr<JsonStreamWriter>(new JsonStreamWriter(OutString));
+    }
+
+    /** Starts the root object or an object inside an array. */
+    bool WriteObjectStart()
+    {
+        if(!BeginValue()){
+            return false;
+        }
+
+        return OpenContainer(EJson::Object, '{');
+    }
+
+    /** Starts an object field that is itself an object. */
+    bool WriteObjectStart(const std::string_view Identifier)
+    {
+        if(!BeginField(Identifier)){
+            return false;
+        }
+
+        return OpenContainer(EJson::Object, '{');
+    }
+
+    /** Closes the innermost object. */
+    bool WriteObjectEnd()
+    {
+        return CloseContainer(EJson::Object, '}');
+    }
+
+    /** Starts the root array or an array inside an array. */
+    bool WriteArrayStart()
+    {
+        if(!BeginValue()){
+            return false;
+        }
+
+        return OpenContainer(EJson::Array, '[');
+    }
+
+    /** Starts an object field that is an array. */
+    bool WriteArrayStart(const std::string_view Identifier)
+    {
+        if(!BeginField(Identifier)){
+            return false;
+        }
+
+        return OpenContainer(EJson::Array, '[');
+    }
+
+    /** Closes the innermost array. */
+    bool WriteArrayEnd()
+    {
+        return CloseContainer(EJson::Array, ']');
+    }
+
+    /**
+     * Writes an element of the innermost array.
+     *
+     * @param Value A string, number or bool.
+    */
+    template<class ValueType>
+    bool WriteValue(const ValueType& Value)
+    {
+        if(!BeginValue() || !CheckInsideContainer()){
+            return false;
+        }
+
+        WriteScalar(Value);
+        return true;
+    }
+
+    /**
+     * Writes a field of the innermost object.
+     *
+     * @param Identifier The name of the field.
+     * @param Value A string, number or bool.
+    */
+    template<class ValueType>
+    bool WriteValue(const std::string_view Identifier, const ValueType& Value)
+    {
+        if(!BeginField(Identifier)){
+            return false;
+        }
+
+        WriteScalar(Value);
+        return true;
+    }
+
+    /** Writes a null element of the innermost array. */
+    bool WriteNull()
+    {
+        return WriteValue(nullptr);
+    }
+
+    /** Writes a null field of the innermost object. */
+    bool WriteNull(const std::string_view Identifier)
+    {
+        return WriteValue(Identifier, nullptr);
+    }
+
+    /**
+     * Writes already formatted Json as an element of the innermost array.
+     * The text is not validated.
+    */
+    bool WriteRawJsonValue(const std::string_view Json)
+    {
+        if(!BeginValue() || !CheckInsideContainer()){
+            return false;
+        }
+
+        Output.Write(Json);
+        return true;
+    }
+
+    /**
+     * Writes already formatted Json as a field of the innermost object.
+     * The text is not validated.
+    */
+    bool WriteRawJsonValue(const std::string_view Identifier, const std::string_view Json)
+    {
+        if(!BeginField(Identifier)){
+            return false;
+        }
+
+        Output.Write(Json);
+        return true;
+    }
+
+    /**
+     * Hands the remaining output to the target.
+     *
+     * @return @c false if the document is incomplete, a call failed earlier or the output failed.
+    */
+    bool Close()
+    {
+        Output.Flush();
+
+        if(!bFailed && (!bRootWritten || !Stack.empty())){
+            SetErrorMessage("Closing a writer with an incomplete document.");
+        }
+
+        if(!bFailed && Output.HasError()){
+            SetErrorMessage("Failed to write to the output stream.");
+        }
+
+        return !bFailed;
+    }
+
+    /** Returns the number of containers currently open */
+    inline std::size_t GetDepth() const { return Stack.size(); }
+
+    /** Gets the error message if a call failed */
+    inline const std::string& GetErrorMessage() const { return ErrorMessage; }
+
+protected:
+    JsonStreamWriter(std::ostream* const OutStream, const std::size_t BlockSize) :
+        Output(OutStream, BlockSize), bFirstInContainer(true), bRootWritten(false), bFailed(false)
+        {}
+
+    JsonStreamWriter(JsonOutputBuffer::SinkFunction Sink, const std::size_t BlockSize) :
+        Output(std::move(Sink), BlockSize), bFirstInContainer(true), bRootWritten(false), bFailed(false)
+        {}
+
+    JsonStreamWriter(std::string* const OutString) :
+        Output(OutString), bFirstInContainer(true), bRootWritten(false), bFailed(false)
+        {}
+
+    /** Checks that an unnamed value may come next and writes the separator before it */
+    bool BeginValue()
+    {
+        if(bFailed){
+            return false;
+        }
+
+        if(Stack.empty()){
+            if(bRootWritten){
+                SetErrorMessage("Only one root value can be written.");
+                return false;
+            }
+
+            return true;
+        }
+
+        if(Stack.back() != EJson::Array){
+            SetErrorMessage("Values inside an object need an identifier.");
+            return false;
+        }
+
+        WriteSeparator();
+        return true;
+    }
+
+    /** Checks that a named value may come next and writes the separator and identifier before it */
+    bool BeginField(const std::string_view Identifier)
+    {
+        if(bFailed){
+            return false;
+        }
+
+        if(Stack.empty() || Stack.back() != EJson::Object){
+            SetErrorMessage("Identifiers can only be written inside an object.");
+            return false;
+        }
+
+        WriteSeparator();
+        Output.WriteString(Identifier);
+        Output.Write(':');
+        PrintPolicy::WriteSpace(Output);
+        return true;
+    }
+
+    /** Fails scalars at the root, which JsonReader doesn't accept */
+    bool CheckInsideContainer()
+    {
+        if(Stack.empty()){
+            SetErrorMessage("The root value must be an object or an array.");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool OpenContainer(const EJson Type, const char Bracket)
+    {
+        Output.Write(Bracket);
+        Stack.push_back(Type);
+        bFirstInContainer = true;
+        bRootWritten = true;
+        return true;
+    }
+
+    bool CloseContainer(const EJson Type, const char Bracket)
+    {
+        if(bFailed){
+            return false;
+        }
+
+        if(Stack.empty() || Stack.back() != Type){
+            SetErrorMessage(Type == EJson::Object ? "Closing an object that is not open." : "Closing an array that is not open.");
+            return false;
+        }
+
+        Stack.pop_back();
+
+        if(!bFirstInContainer){
+            PrintPolicy::WriteLineTerminator(Output);
+            PrintPolicy::WriteTabs(Output, static_cast<std::int32_t>(Stack.size()));
+        }
+
+        Output.Write(Bracket);
+        bFirstInContainer = false;
+        return true;
+    }
+
+    void WriteSeparator()
+    {
+        if(!bFirstInContainer){
+            Output.Write(',');
+        }
+
+        bFirstInContainer = false;
+
+        PrintPolicy::WriteLineTerminator(Output);
+        PrintPolicy::WriteTabs(Output, static_cast<std::int32_t>(Stack.size()));
+    }
+
+    template<class ValueType>
+    void WriteScalar(const ValueType& Value)
+    {
+        if constexpr (std::is_same_v<ValueType, std::nullptr_t>){
+            Output.Write("null", 4);
+        }else if constexpr (std::is_same_v<ValueType, bool>){
+            if(Value){
+                Output.Write("true", 4);
+            }else{
+                Output.Write("false", 5);
+            }
+        }else if constexpr (std::is_integral_v<ValueType> && std::is_signed_v<ValueType>){
+            Output.WriteNumber(static_cast<std::int64_t>(Value));
+        }else if constexpr (std::is_integral_v<ValueType>){
+            Output.WriteNumber(static_cast<std::uint64_t>(Value));
+        }else if constexpr (std::is_floating_point_v<ValueType>){
+            Output.WriteNumber(static_cast<double>(Value));
+        }else{
+            static_assert(std::is_convertible_v<const ValueType&, std::string_view>, "Unsupported value type");
+            Output.WriteString(std::string_view(Value));
+        }
+    }
+
+    void SetErrorMessage(const std::string& Message)
+    {
+        ErrorMessage = Message;
+        bFailed = true;
+    }
+
+    JsonOutputBuffer Output;
+
+    // Containers currently open, innermost last
+    std::vector<EJson> Stack;
+
+    std::string ErrorMessage;
+
+    bool bFirstInContainer;
+    bool bRootWritten;
+    bool bFailed;
+};
+
+} // namespace zexjson
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Minimal.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+
+namespace zexjson{
+
+/**
+ * A fixed set of worker threads running queued tasks in the order they were submitted.
+ *
+ * Used by the parallel parsing drivers, which split their input into tasks
+ * and track completion themselves. One pool can be shared between drivers.
+*/
+class JsonThreadPool
+{
+public:
+    using TaskFunction = std::function<void()>;
+
+    /**
+     * Starts the workers.
+     *
+     * @param ThreadCount Number of workers, or 0 for one per hardware thread.
+    */
+    explicit JsonThreadPool(std::size_t ThreadCount = 0);
+
+    JsonThreadPool(const JsonThreadPool&) = delete;
+    JsonThreadPool& operator=(const JsonThreadPool&) = delete;
+
+    /** Runs the tasks still queued, then joins the workers. */
+    ~JsonThreadPool();
+
+    /** Queues a task to run on the next free worker. */
+    void Submit(TaskFunction Task);
+
+    inline std::size_t GetThreadCount() const { return Workers.size(); }
+
+protected:
+    void RunWorker();
+
+    std::vector<std::thread> Workers;
+    std::deque<TaskFunction> Tasks;
+
+    std::mutex Mutex;
+    std::condition_variable TaskAvailable;
+    bool bStopping;
+};
+
+} // namespace zexjson
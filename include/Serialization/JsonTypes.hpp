@@ -16,6 +16,17 @@ enum class EJson
     Object
 };
 
+/**
+ * How a Json Number is stored, based on its lexical form.
+ * Integers are kept exactly whenever they fit in 64 bits.
+ */
+enum class EJsonNumber
+{
+    Double,
+    Int64,
+    UInt64
+};
+
 enum class EJsonToken
 {
     None,
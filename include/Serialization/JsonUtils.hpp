@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Minimal.hpp"
+
+
+namespace zexjson::JsonUtils{
+
+/** Returns the value of a hexadecimal digit, or zero if the character is not one. */
+template<class CharType>
+inline std::int32_t ParseHexDigit(const CharType Char)
+{
+    if(Char >= CharType('0') && Char <= CharType('9')){
+        return Char - CharType('0');
+    }
+
+    if(Char >= CharType('a') && Char <= CharType('f')){
+        return Char - CharType('a') + 10;
+    }
+
+    if(Char >= CharType('A') && Char <= CharType('F')){
+        return Char - CharType('A') + 10;
+    }
+
+    return 0;
+}
+
+/** Appends a code point to the string, encoded as UTF-8. */
+inline void AppendUtf8(std::string& String, const std::uint32_t CodePoint)
+{
+    if(CodePoint < 0x80){
+        String += static_cast<char>(CodePoint);
+    }else if(CodePoint < 0x800){
+        String += static_cast<char>(0xC0 | (CodePoint >> 6));
+        String += static_cast<char>(0x80 | (CodePoint & 0x3F));
+    }else if(CodePoint < 0x10000){
+        String += static_cast<char>(0xE0 | (CodePoint >> 12));
+        String += static_cast<char>(0x80 | ((CodePoint >> 6) & 0x3F));
+        String += static_cast<char>(0x80 | (CodePoint & 0x3F));
+    }else{
+        String += static_cast<char>(0xF0 | (CodePoint >> 18));
+        String += static_cast<char>(0x80 | ((CodePoint >> 12) & 0x3F));
+        String += static_cast<char>(0x80 | ((CodePoint >> 6) & 0x3F));
+        String += static_cast<char>(0x80 | (CodePoint & 0x3F));
+    }
+}
+
+/**
+ * Appends the UTF-16 code unit of a \\u escape to the string as UTF-8.
+ *
+ * Json escapes characters beyond the Basic Multilingual Plane as a surrogate
+ * pair, e.g. \\ud83d\\ude00, which must be combined into a single code point
+ * rather than encoded half by half.
+ *
+ * @param String The string to append to.
+ * @param Unit The code unit of the escape.
+ * @param PendingHighSurrogate A high surrogate waiting for the low half that must follow it, or zero. Updated.
+ * @return @c false if a surrogate lacks its other half.
+*/
+inline bool AppendUtf16Unit(std::string& String, const std::uint32_t Unit, std::uint32_t& PendingHighSurrogate)
+{
+    const bool bHighSurrogate = Unit >= 0xD800 && Unit <= 0xDBFF;
+    const bool bLowSurrogate = Unit >= 0xDC00 && Unit <= 0xDFFF;
+
+    if(PendingHighSurrogate != 0){
+        if(!bLowSurrogate){
+            return false;
+        }
+
+        AppendUtf8(String, 0x10000 + ((PendingHighSurrogate - 0xD800) << 10) + (Unit - 0xDC00));
+        PendingHighSurrogate = 0;
+        return true;
+    }
+
+    if(bLowSurrogate){
+        return false;
+    }
+
+    if(bHighSurrogate){
+        PendingHighSurrogate = Unit;
+        return true;
+    }
+
+    AppendUtf8(String, Unit);
+    return true;
+}
+
+/** Case-insensitive comparison of two ASCII strings. */
+inline bool EqualsIgnoreCase(const std::string_view Lhs, const std::string_view Rhs)
+{
+    if(Lhs.size() != Rhs.size()){
+        return false;
+    }
+
+    for(std::size_t i{0}; i < Lhs.size(); ++i){
+        const char L = (Lhs[i] >= 'A' && Lhs[i] <= 'Z') ? Lhs[i] - 'A' + 'a' : Lhs[i];
+        const char R = (Rhs[i] >= 'A' && Rhs[i] <= 'Z') ? Rhs[i] - 'A' + 'a' : Rhs[i];
+
+        if(L != R){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace zexjson::JsonUtils
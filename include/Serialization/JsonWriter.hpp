@@ -0,0 +1,433 @@
+#pragma once
+
+#include "Minimal.hpp"
+#include "Domain/JsonValue.hpp"
+#include "Domain/JsonObject.hpp"
+#include "Domain/JsonCompactValue.hpp"
+#include "Domain/JsonFrozenDocument.hpp"
+#include "Serialization/JsonOutputBuffer.hpp"
+#include "Serialization/JsonPrintPolicy.hpp"
+
+
+namespace zexjson{
+
+/**
+ * Writes JsonValue, JsonObject, JsonCompactValue and JsonFrozenValue trees out as Json text.
+ *
+ * Output goes into a JsonOutputBuffer, so it either grows a string in place or
+ * reaches a stream in large blocks. Containers are walked without recursion.
+ *
+ * @param PrintPolicy CondensedJsonPrintPolicy or PrettyJsonPrintPolicy.
+*/
+template<class PrintPolicy = PrettyJsonPrintPolicy>
+class JsonWriter
+{
+public:
+    /**
+     * Creates a writer that appends to a string.
+     *
+     * @param OutString The string to append to. Its contents are complete once Close() is called.
+     * @param SizeHint Expected size of the output, reserved up front.
+    */
+    static std::shared_ptr<JsonWriter> Create(std::string* const OutString, const std::size_t SizeHint = 0)
+    {
+        return std::shared_ptr<JsonWriter>(new JsonWriter(OutString, SizeHint));
+    }
+
+    /**
+     * Creates a writer that outputs to a stream in blocks.
+     *
+     * @param OutStream The stream to write to, which must outlive the writer.
+     * @param BlockSize Size of the blocks handed to the stream.
+    */
+    static std::shared_ptr<JsonWriter> Create(std::ostream* const OutStream, const std::size_t BlockSize = JsonOutputBuffer::DefaultBlockSize)
+    {
+        return std::shared_ptr<JsonWriter>(new JsonWriter(OutStream, BlockSize));
+    }
+
+    /** Writes a value and everything below it. */
+    void Write(const JsonValue& Value)
+    {
+        std::vector<ValueFrame> Stack;
+        WriteOrPush(&Value, Stack);
+        Drain(Stack);
+    }
+
+    /** Writes an object and everything below it. */
+    void Write(const JsonObject& Object)
+    {
+        std::vector<ValueFrame> Stack;
+        Output.Write('{');
+        Stack.push_back(ValueFrame{&Object, Object.Values.begin(), nullptr, 0, true});
+        Drain(Stack);
+    }
+
+    /** Writes an array and everything below it. */
+    void Write(const JsonArray& Array)
+    {
+        std::vector<ValueFrame> Stack;
+        Output.Write('[');
+        Stack.push_back(ValueFrame{nullptr, {}, &Array, 0, true});
+        Drain(Stack);
+    }
+
+    /** Writes a compact value and everything below it. */
+    void Write(const JsonCompactValue& Value)
+    {
+        std::vector<CompactFrame> Stack;
+        WriteOrPush(&Value, Stack);
+        Drain(Stack);
+    }
+
+    /** Writes a frozen value and everything below it. */
+    void Write(const JsonFrozenValue& Value)
+    {
+        std::vector<FrozenFrame> Stack;
+        WriteOrPush(&Value, Stack);
+        Drain(Stack);
+    }
+
+    /**
+     * Makes all output visible to the target.
+     *
+     * @return @c false if writing to the stream failed.
+    */
+    bool Close()
+    {
+        Output.Flush();
+        return !Output.HasError();
+    }
+
+protected:
+    JsonWriter(std::string* const OutString, const std::size_t SizeHint) :
+        Output(OutString, SizeHint)
+        {}
+
+    JsonWriter(std::ostream* const OutStream, const std::size_t BlockSize) :
+        Output(OutStream, BlockSize)
+        {}
+
+    using ObjectIterator = typename decltype(JsonObject::Values)::const_iterator;
+
+    /** A container of a JsonValue tree being written; either Object or Array is set */
+    struct ValueFrame
+    {
+        const JsonObject* Object;
+        ObjectIterator It;
+        const JsonArray* Array;
+        std::size_t Index;
+        bool bFirst;
+    };
+
+    /** A container of a JsonCompactValue tree being written; either Object or Array is set */
+    struct CompactFrame
+    {
+        const JsonCompactValue::ObjectType* Object;
+        const JsonCompactValue::ArrayType* Array;
+        std::size_t Index;
+        bool bFirst;
+    };
+
+    /** A container of a JsonFrozenValue tree being written */
+    struct FrozenFrame
+    {
+        const JsonFrozenValue* Container;
+        std::size_t Index;
+        bool bFirst;
+    };
+
+    /** Writes everything left in the open containers, closing them on the way up */
+    void Drain(std::vector<ValueFrame>& Stack)
+    {
+        while(!Stack.empty()){
+            ValueFrame& Frame = Stack.back();
+            const JsonValue* Child;
+
+            if(Frame.Object){
+                if(Frame.It == Frame.Object->Values.end()){
+                    CloseContainer('}', Frame.bFirst, Stack.size());
+                    Stack.pop_back();
+                    continue;
+                }
+
+                WriteSeparator(Frame.bFirst, Stack.size());
+                WriteIdentifier(Frame.It->first);
+                Child = Frame.It->second.get();
+                ++Frame.It;
+            }else{
+                if(Frame.Index == Frame.Array->size()){
+                    CloseContainer(']', Frame.bFirst, Stack.size());
+                    Stack.pop_back();
+                    continue;
+                }
+
+                WriteSeparator(Frame.bFirst, Stack.size());
+                Child = (*Frame.Array)[Frame.Index++].get();
+            }
+
+            WriteOrPush(Child, Stack);
+        }
+    }
+
+    /** Writes everything left in the open containers, closing them on the way up */
+    void Drain(std::vector<CompactFrame>& Stack)
+    {
+        while(!Stack.empty()){
+            CompactFrame& Frame = Stack.back();
+            const JsonCompactValue* Child;
+
+            if(Frame.Object){
+                if(Frame.Index == Frame.Object->size()){
+                    CloseContainer('}', Frame.bFirst, Stack.size());
+                    Stack.pop_back();
+                    continue;
+                }
+
+                const auto& Field = (*Frame.Object)[Frame.Index++];
+                WriteSeparator(Frame.bFirst, Stack.size());
+                WriteIdentifier(Field.first);
+                Child = &Field.second;
+            }else{
+                if(Frame.Index == Frame.Array->size()){
+                    CloseContainer(']', Frame.bFirst, Stack.size());
+                    Stack.pop_back();
+                    continue;
+                }
+
+                WriteSeparator(Frame.bFirst, Stack.size());
+                Child = &(*Frame.Array)[Frame.Index++];
+            }
+
+            WriteOrPush(Child, Stack);
+        }
+    }
+
+    /** Writes a scalar, or opens a container and pushes it to be written by Drain */
+    void WriteOrPush(const JsonValue* Value, std::vector<ValueFrame>& Stack)
+    {
+        if(!Value){
+            Output.Write("null", 4);
+            return;
+        }
+
+        switch (Value->Type)
+        {
+        case EJson::String:
+            Output.WriteString(static_cast<const JsonValueString*>(Value)->GetString());
+            break;
+
+        case EJson::Number:
+            WriteNumber(*static_cast<const JsonValueNumber*>(Value));
+            break;
+
+        case EJson::Boolean:
+            WriteBoolean(Value->AsBool());
+            break;
+
+        case EJson::Array:
+            Output.Write('[');
+            Stack.push_back(ValueFrame{nullptr, {}, &Value->AsArray(), 0, true});
+            break;
+
+        case EJson::Object:
+        {
+            const std::shared_ptr<JsonObject>& Object = Value->AsObject();
+
+            if(!Object){
+                Output.Write("null", 4);
+                break;
+            }
+
+            Output.Write('{');
+            Stack.push_back(ValueFrame{Object.get(), Object->Values.begin(), nullptr, 0, true});
+            break;
+        }
+
+        default:
+            Output.Write("null", 4);
+            break;
+        }
+    }
+
+    /** Writes a scalar, or opens a container and pushes it to be written by Drain */
+    void WriteOrPush(const JsonCompactValue* Value, std::vector<CompactFrame>& Stack)
+    {
+        switch (Value->GetType())
+        {
+        case EJson::String:
+            Output.WriteString(Value->AsStringView());
+            break;
+
+        case EJson::Number:
+            WriteNumber(*Value);
+            break;
+
+        case EJson::Boolean:
+            WriteBoolean(Value->AsBool());
+            break;
+
+        case EJson::Array:
+            Output.Write('[');
+            Stack.push_back(CompactFrame{nullptr, &Value->AsArray(), 0, true});
+            break;
+
+        case EJson::Object:
+            Output.Write('{');
+            Stack.push_back(CompactFrame{&Value->AsObject(), nullptr, 0, true});
+            break;
+
+        default:
+            Output.Write("null", 4);
+            break;
+        }
+    }
+
+    /** Writes everything left in the open containers, closing them on the way up */
+    void Drain(std::vector<FrozenFrame>& Stack)
+    {
+        while(!Stack.empty()){
+            FrozenFrame& Frame = Stack.back();
+            const JsonFrozenValue* Child;
+
+            if(Frame.Index == Frame.Container->GetSize()){
+                CloseContainer(Frame.Container->GetType() == EJson::Object ? '}' : ']', Frame.bFirst, Stack.size());
+                Stack.pop_back();
+                continue;
+            }
+
+            WriteSeparator(Frame.bFirst, Stack.size());
+
+            if(Frame.Container->GetType() == EJson::Object){
+                const JsonFrozenField& Field = Frame.Container->AsObject()[Frame.Index++];
+
+                WriteIdentifier(Field.GetName());
+                Child = &Field.GetValue();
+            }else{
+                Child = Frame.Container->GetElement(Frame.Index++);
+            }
+
+            WriteOrPush(Child, Stack);
+        }
+    }
+
+    /** Writes a scalar, or opens a container and pushes it to be written by Drain */
+    void WriteOrPush(const JsonFrozenValue* Value, std::vector<FrozenFrame>& Stack)
+    {
+        switch (Value->GetType())
+        {
+        case EJson::String:
+            Output.WriteString(Value->AsStringView());
+            break;
+
+        case EJson::Number:
+            WriteNumber(*Value);
+            break;
+
+        case EJson::Boolean:
+            WriteBoolean(Value->AsBool());
+            break;
+
+        case EJson::Array:
+            Output.Write('[');
+            Stack.push_back(FrozenFrame{Value, 0, true});
+            break;
+
+        case EJson::Object:
+            Output.Write('{');
+            Stack.push_back(FrozenFrame{Value, 0, true});
+            break;
+
+        default:
+            Output.Write("null", 4);
+            break;
+        }
+    }
+
+    /** Writes a number in the form it's stored in, so integers stay exact */
+    template<class NumberType>
+    void WriteNumber(const NumberType& Number)
+    {
+        switch (Number.GetNumberType())
+        {
+        case EJsonNumber::Int64:
+        {
+            std::int64_t Int64{0};
+            Number.TryGetNumber(Int64);
+            Output.WriteNumber(Int64);
+            break;
+        }
+
+        case EJsonNumber::UInt64:
+        {
+            std::uint64_t UInt64{0};
+            Number.TryGetNumber(UInt64);
+            Output.WriteNumber(UInt64);
+            break;
+        }
+
+        default:
+            Output.WriteNumber(Number.AsNumber());
+            break;
+        }
+    }
+
+    void WriteBoolean(const bool Value)
+    {
+        if(Value){
+            Output.Write("true", 4);
+        }else{
+            Output.Write("false", 5);
+        }
+    }
+
+    void WriteIdentifier(const std::string_view Identifier)
+    {
+        Output.WriteString(Identifier);
+        Output.Write(':');
+        PrintPolicy::WriteSpace(Output);
+    }
+
+    /** Starts the next element of a container at the given depth */
+    void WriteSeparator(bool& bFirst, const std::size_t Depth)
+    {
+        if(!bFirst){
+            Output.Write(',');
+        }
+
+        bFirst = false;
+
+        PrintPolicy::WriteLineTerminator(Output);
+        PrintPolicy::WriteTabs(Output, static_cast<std::int32_t>(Depth));
+    }
+
+    /** Closes a container at the given depth, keeping empty ones on a single line */
+    void CloseContainer(const char Bracket, const bool bEmpty, const std::size_t Depth)
+    {
+        if(!bEmpty){
+            PrintPolicy::WriteLineTerminator(Output);
+            PrintPolicy::WriteTabs(Output, static_cast<std::int32_t>(Depth) - 1);
+        }
+
+        Output.Write(Bracket);
+    }
+
+    JsonOutputBuffer Output;
+};
+
+
+template<class PrintPolicy = PrettyJsonPrintPolicy>
+class JsonWriterFactory
+{
+public:
+    static std::shared_ptr<JsonWriter<PrintPolicy>> Create(std::string* const OutString, const std::size_t SizeHint = 0)
+    {
+        return JsonWriter<PrintPolicy>::Create(OutString, SizeHint);
+    }
+
+    static std::shared_ptr<JsonWriter<PrintPolicy>> Create(std::ostream* const OutStream, const std::size_t BlockSize = JsonOutputBuffer::DefaultBlockSize)
+    {
+        return JsonWriter<PrintPolicy>::Create(OutStream, BlockSize);
+    }
+};
+
+} // namespace zexjson
@@ -0,0 +1,336 @@
+#include "Domain/JsonCompactValue.hpp"
+#include "Serialization/JsonUtils.hpp"
+
+#include <cstddef>
+
+using namespace zexjson;
+
+JsonCompactValue::JsonCompactValue(std::uint64_t InNumber) :
+    Storage{}, Kind(EKind::UInt64)
+{
+    Store(InNumber);
+
+    // Keep a single representation for every integer that fits in int64
+    if(InNumber <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())){
+        Kind = EKind::Int64;
+    }
+}
+
+JsonCompactValue::JsonCompactValue(std::string_view InString) :
+    Storage{}, Kind(EKind::None)
+{
+    SetString(InString);
+}
+
+JsonCompactValue::JsonCompactValue(ArrayType&& InArray) :
+    Storage{}, Kind(EKind::Array)
+{
+    Store(new ArrayType(std::move(InArray)));
+}
+
+JsonCompactValue::JsonCompactValue(ObjectType&& InObject) :
+    Storage{}, Kind(EKind::Object)
+{
+    Store(new ObjectType(std::move(InObject)));
+}
+
+JsonCompactValue::JsonCompactValue(const JsonCompactValue& Other) :
+    Storage{}, Kind(EKind::None)
+{
+    CopyFrom(Other);
+}
+
+JsonCompactValue::JsonCompactValue(JsonCompactValue&& Other) noexcept :
+    Kind(Other.Kind)
+{
+    std::memcpy(Storage, Other.Storage, sizeof(Storage));
+    Other.Kind = EKind::None;
+}
+
+JsonCompactValue& JsonCompactValue::operator=(const JsonCompactValue& Other)
+{
+    if(this != &Other){
+        // Copy first, Other may live inside the array or object being released
+        JsonCompactValue Copy(Other);
+        *this = std::move(Copy);
+    }
+
+    return *this;
+}
+
+JsonCompactValue& JsonCompactValue::operator=(JsonCompactValue&& Other) noexcept
+{
+    if(this != &Other){
+        JsonCompactValue Old;
+        std::memcpy(Old.Storage, Storage, sizeof(Storage));
+        Old.Kind = Kind;
+
+        std::memcpy(Storage, Other.Storage, sizeof(Storage));
+        Kind = Other.Kind;
+        Other.Kind = EKind::None;
+    }
+
+    return *this;
+}
+
+void JsonCompactValue::SetString(std::string_view InString)
+{
+    if(InString.size() <= InlineCapacity){
+        if(!InString.empty()){
+            std::memcpy(Storage, InString.data(), InString.size());
+        }
+
+        Storage[InlineCapacity] = static_cast<char>(InString.size());
+        Kind = EKind::SmallString;
+        return;
+    }
+
+    void* Block = ::operator new(offsetof(HeapString, Data) + InString.size() + 1);
+    HeapString* String = static_cast<HeapString*>(Block);
+    String->Length = InString.size();
+    std::memcpy(String->Data, InString.data(), InString.size());
+    String->Data[InString.size()] = '\0';
+
+    Store(String);
+    Kind = EKind::HeapString;
+}
+
+void JsonCompactValue::CopyFrom(const JsonCompactValue& Other)
+{
+    switch (Other.Kind)
+    {
+    case EKind::HeapString:
+        SetString(Other.AsStringView());
+        break;
+
+    case EKind::Array:
+        Store(new ArrayType(*Other.Load<ArrayType*>()));
+        Kind = EKind::Array;
+        break;
+
+    case EKind::Object:
+        Store(new ObjectType(*Other.Load<ObjectType*>()));
+        Kind = EKind::Object;
+        break;
+
+    default:
+        std::memcpy(Storage, Other.Storage, sizeof(Storage));
+        Kind = Other.Kind;
+        break;
+    }
+}
+
+void JsonCompactValue::Release()
+{
+    switch (Kind)
+    {
+    case EKind::HeapString:
+        ::operator delete(Load<HeapString*>());
+        break;
+
+    case EKind::Array:
+        delete Load<ArrayType*>();
+        break;
+
+    case EKind::Object:
+        delete Load<ObjectType*>();
+        break;
+
+    default:
+        break;
+    }
+
+    Kind = EKind::None;
+}
+
+const JsonCompactValue::ArrayType& JsonCompactValue::AsArray() const
+{
+    const ArrayType* Array{nullptr};
+
+    if(!TryGetArray(Array)){
+        static const ArrayType EmptyArray;
+        Array = &EmptyArray;
+    }
+
+    return *Array;
+}
+
+const JsonCompactValue::ObjectType& JsonCompactValue::AsObject() const
+{
+    const ObjectType* Object{nullptr};
+
+    if(!TryGetObject(Object)){
+        static const ObjectType EmptyObject;
+        Object = &EmptyObject;
+    }
+
+    return *Object;
+}
+
+bool JsonCompactValue::TryGetString(std::string& OutString) const
+{
+    char Buffer[32];
+    std::to_chars_result Result;
+
+    switch (Kind)
+    {
+    case EKind::SmallString:
+    case EKind::HeapString:
+        OutString = AsStringView();
+        return true;
+
+    case EKind::Boolean:
+        OutString = Load<bool>() ? "true" : "false";
+        return true;
+
+    case EKind::Double:
+        Result = std::to_chars(Buffer, Buffer + sizeof(Buffer), Load<double>());
+        break;
+
+    case EKind::Int64:
+        Result = std::to_chars(Buffer, Buffer + sizeof(Buffer), Load<std::int64_t>());
+        break;
+
+    case EKind::UInt64:
+        Result = std::to_chars(Buffer, Buffer + sizeof(Buffer), Load<std::uint64_t>());
+        break;
+
+    default:
+        return false;
+    }
+
+    OutString.assign(Buffer, Result.ptr);
+    return true;
+}
+
+bool JsonCompactValue::TryGetBool(bool& OutBool) const
+{
+    switch (Kind)
+    {
+    case EKind::Boolean:
+        OutBool = Load<bool>();
+        return true;
+
+    case EKind::Double:
+    case EKind::Int64:
+    case EKind::UInt64:
+        OutBool = AsNumber() != 0.0;
+        return true;
+
+    case EKind::SmallString:
+    case EKind::HeapString:
+    {
+        const std::string_view String = AsStringView();
+        double Number;
+
+        if(ParseNumber(String, Number)){
+            OutBool = Number != 0.0;
+        }else{
+            OutBool = JsonUtils::EqualsIgnoreCase(String, "true") ||
+                JsonUtils::EqualsIgnoreCase(String, "yes") ||
+                JsonUtils::EqualsIgnoreCase(String, "on");
+        }
+
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+const JsonCompactValue* JsonCompactValue::TryGetField(std::string_view FieldName) const
+{
+    const ObjectType* Object;
+
+    if(!TryGetObject(Object)){
+        return nullptr;
+    }
+
+    for(const auto& Field : *Object){
+        if(Field.first == FieldName){
+            return &Field.second;
+        }
+    }
+
+    return nullptr;
+}
+
+// static
+bool JsonCompactValue::ParseNumber(std::string_view String, double& OutNumber)
+{
+    const char* const End = String.data() + String.size();
+    const std::from_chars_result Result = std::from_chars(String.data(), End, OutNumber);
+
+    return !String.empty() && Result.ec == std::errc() && Result.ptr == End;
+}
+
+// static
+bool JsonCompactValue::CompareEqual(const JsonCompactValue& Lhs, const JsonCompactValue& Rhs)
+{
+    const EJson Type = Lhs.GetType();
+
+    if(Type != Rhs.GetType()){
+        return false;
+    }
+
+    switch (Type)
+    {
+    case EJson::None:
+    case EJson::Null:
+        return true;
+
+    case EJson::String:
+        return Lhs.AsStringView() == Rhs.AsStringView();
+
+    case EJson::Number:
+        if(Lhs.Kind != EKind::Double && Rhs.Kind != EKind::Double){
+            // Int64 and UInt64 ranges don't overlap, see the UInt64 constructor
+            return Lhs.Kind == Rhs.Kind && Lhs.Load<std::int64_t>() == Rhs.Load<std::int64_t>();
+        }
+
+        return Lhs.AsNumber() == Rhs.AsNumber();
+
+    case EJson::Boolean:
+        return Lhs.Load<bool>() == Rhs.Load<bool>();
+
+    case EJson::Array:
+    {
+        const ArrayType& LhsArray = Lhs.AsArray();
+        const ArrayType& RhsArray = Rhs.AsArray();
+
+        if(LhsArray.size() != RhsArray.size()){
+            return false;
+        }
+
+        for(std::size_t i{0}; i < LhsArray.size(); ++i){
+            if(!CompareEqual(LhsArray[i], RhsArray[i])){
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    case EJson::Object:
+    {
+        const ObjectType& LhsObject = Lhs.AsObject();
+
+        if(LhsObject.size() != Rhs.AsObject().size()){
+            return false;
+        }
+
+        for(const auto& Field : LhsObject){
+            const JsonCompactValue* RhsValue = Rhs.TryGetField(Field.first);
+
+            if(!RhsValue || !CompareEqual(Field.second, *RhsValue)){
+                return false;
+            }
+        }
+
+        return true;
+    }
+    }
+
+    return false;
+}
@@ -0,0 +1,30 @@
+#include "Domain/JsonDocument.hpp"
+
+#include <cstddef>
+
+using namespace zexjson;
+
+JsonArena::JsonArena(std::size_t InitialBlockSize, bool bInternNames) :
+    Resource(InitialBlockSize), AllocatedBytes(0), NamePool(bInternNames ? std::make_unique<JsonNamePool>(this) : nullptr)
+{}
+
+JsonName JsonArena::MakeName(const std::string_view Name)
+{
+    if(NamePool){
+        return NamePool->Intern(Name);
+    }
+
+    if(Name.size() <= JsonName::InlineCapacity){
+        return JsonName(Name);
+    }
+
+    JsonName::Record* Record = static_cast<JsonName::Record*>(Allocate(offsetof(JsonName::Record, Chars) + Name.size(), alignof(JsonName::Record)));
+    Record->Length = Name.size();
+    std::memcpy(Record->Chars, Name.data(), Name.size());
+
+    return JsonName(static_cast<const JsonName::Record*>(Record));
+}
+
+JsonDocument::JsonDocument(std::size_t InitialBlockSize, bool bInternNames) :
+    Arena(std::make_unique<JsonArena>(InitialBlockSize, bInternNames)), Root()
+{}
@@ -0,0 +1,129 @@
+#include "Domain/JsonFieldMap.hpp"
+#include "Domain/JsonValue.hpp"
+
+using namespace zexjson;
+
+std::shared_ptr<JsonValue>& JsonFieldMap::operator[](const JsonKey& Key)
+{
+    const std::size_t Position = FindIndex(Key);
+
+    if(Position != Entries.size()){
+        return Entries[Position].second;
+    }
+
+    return Append(JsonName(Key.GetName()), static_cast<std::uint32_t>(Key.GetHash()), nullptr)->second;
+}
+
+std::pair<JsonFieldMap::iterator, bool> JsonFieldMap::emplace(JsonName Name, std::shared_ptr<JsonValue> Value)
+{
+    const JsonKey Key(Name);
+    const std::size_t Position = FindIndex(Key);
+
+    if(Position != Entries.size()){
+        return {Entries.begin() + Position, false};
+    }
+
+    return {Append(std::move(Name), static_cast<std::uint32_t>(Key.GetHash()), std::move(Value)), true};
+}
+
+std::pair<JsonFieldMap::iterator, bool> JsonFieldMap::insert_or_assign(JsonName Name, std::shared_ptr<JsonValue> Value)
+{
+    const JsonKey Key(Name);
+    const std::size_t Position = FindIndex(Key);
+
+    if(Position != Entries.size()){
+        Entries[Position].second = std::move(Value);
+        return {Entries.begin() + Position, false};
+    }
+
+    return {Append(std::move(Name), static_cast<std::uint32_t>(Key.GetHash()), std::move(Value)), true};
+}
+
+JsonFieldMap::iterator JsonFieldMap::erase(const_iterator Position)
+{
+    const std::size_t Offset = Position - Entries.cbegin();
+
+    Tags.erase(Tags.begin() + Offset);
+    const iterator Next = Entries.erase(Position);
+
+    // Later entries moved down by one, so their slots are stale
+    if(!Index.empty()){
+        RebuildIndex(Entries.size());
+    }
+
+    return Next;
+}
+
+std::size_t JsonFieldMap::erase(const JsonKey& Key)
+{
+    const std::size_t Position = FindIndex(Key);
+
+    if(Position == Entries.size()){
+        return 0;
+    }
+
+    erase(Entries.cbegin() + Position);
+    return 1;
+}
+
+void JsonFieldMap::reserve(std::size_t Count)
+{
+    Entries.reserve(Count);
+    Tags.reserve(Count);
+
+    if(Count > IndexThreshold){
+        RebuildIndex(Count);
+    }
+}
+
+void JsonFieldMap::clear()
+{
+    Entries.clear();
+    Tags.clear();
+    Index.clear();
+}
+
+JsonFieldMap::iterator JsonFieldMap::Append(JsonName&& Name, std::uint32_t Tag, std::shared_ptr<JsonValue>&& Value)
+{
+    Entries.emplace_back(std::move(Name), std::move(Value));
+    Tags.push_back(Tag);
+
+    if(!Index.empty()){
+        // Keep the table at most half full
+        if(Entries.size() * 2 > Index.size()){
+            RebuildIndex(Entries.size());
+        }else{
+            InsertIntoIndex(Entries.size() - 1);
+        }
+    }else if(Entries.size() > IndexThreshold){
+        RebuildIndex(Entries.size());
+    }
+
+    return Entries.end() - 1;
+}
+
+void JsonFieldMap::RebuildIndex(std::size_t Count)
+{
+    std::size_t Size = 16;
+    while(Size < Count * 2){
+        Size *= 2;
+    }
+
+    Index.assign(Size, 0);
+
+    for(std::size_t i{0}; i < Entries.size(); ++i){
+        InsertIntoIndex(i);
+    }
+}
+
+void JsonFieldMap::InsertIntoIndex(std::size_t Position)
+{
+    const std::size_t Mask = Index.size() - 1;
+    std::size_t Slot = Tags[Position] & Mask;
+
+    while(Index[Slot] != 0){
+        Slot = (Slot + 1) & Mask;
+    }
+
+    Index[Slot] = static_cast<std::uint32_t>(Position + 1);
+}
@@ -0,0 +1,607 @@
+#include "Domain/JsonFrozenDocument.hpp"
+#include "Serialization/JsonUtils.hpp"
+
+#include <charconv>
+#include <unordered_map>
+
+using namespace zexjson;
+
+namespace{
+
+/** Objects with up to this many fields are searched linearly */
+constexpr std::size_t LinearSearchLimit = 8;
+
+/** Rounds a double into an integer type, returning false if it's out of range */
+template<typename T>
+bool ConvertDouble(const double Double, T& OutNumber)
+{
+    // 2^63 and 2^64 are exact as doubles, unlike the numeric limits of the 64-bit types
+    constexpr double Upper = std::is_same_v<T, std::uint64_t> ? 18446744073709551616.0 :
+        (std::is_same_v<T, std::int64_t> ? 9223372036854775808.0 : static_cast<double>(std::numeric_limits<T>::max()) + 1.0);
+
+    if(Double >= static_cast<double>(std::numeric_limits<T>::min()) && Double < Upper){
+        const double Rounded = std::round(Double);
+
+        if(Rounded < Upper){
+            OutNumber = static_cast<T>(Rounded);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/** Parses the whole string as a number */
+template<typename T>
+bool ParseWhole(const std::string_view String, T& OutNumber)
+{
+    const char* const End = String.data() + String.size();
+    const std::from_chars_result Result = std::from_chars(String.data(), End, OutNumber);
+
+    return !String.empty() && Result.ec == std::errc() && Result.ptr == End;
+}
+
+/** Returns the container a value of the source tree holds, materializing lazy values; both are null for scalars */
+void GetContainer(const JsonValue& Value, const JsonArray*& OutArray, const JsonObject*& OutObject)
+{
+    OutArray = nullptr;
+    OutObject = nullptr;
+
+    if(Value.Type == EJson::Array){
+        Value.TryGetArray(OutArray);
+    }else if(Value.Type == EJson::Object){
+        const std::shared_ptr<JsonObject>* Object;
+
+        if(Value.TryGetObject(Object)){
+            OutObject = Object->get();
+        }
+    }
+}
+
+} // namespace
+
+template<typename T>
+bool JsonFrozenValue::TryGetInteger(T& OutNumber) const
+{
+    if(Kind == EKind::Int64){
+        const std::int64_t Int64 = Payload.Int64;
+
+        if constexpr (std::is_signed_v<T>){
+            if(Int64 < std::numeric_limits<T>::min() || Int64 > std::numeric_limits<T>::max()){
+                return false;
+            }
+        }else{
+            if(Int64 < 0 || static_cast<std::uint64_t>(Int64) > std::numeric_limits<T>::max()){
+                return false;
+            }
+        }
+
+        OutNumber = static_cast<T>(Int64);
+        return true;
+    }
+
+    if(Kind == EKind::UInt64){
+        if(Payload.UInt64 > static_cast<std::uint64_t>(std::numeric_limits<T>::max())){
+            return false;
+        }
+
+        OutNumber = static_cast<T>(Payload.UInt64);
+        return true;
+    }
+
+    if(Kind == EKind::String && ParseWhole(AsStringView(), OutNumber)){
+        return true;
+    }
+
+    double Double;
+
+    if(!TryGetNumber(Double)){
+        return false;
+    }
+
+    return ConvertDouble(Double, OutNumber);
+}
+
+bool JsonFrozenValue::TryGetNumber(double& OutNumber) const
+{
+    switch (Kind)
+    {
+    case EKind::Double:
+        OutNumber = Payload.Double;
+        return true;
+
+    case EKind::Int64:
+        OutNumber = static_cast<double>(Payload.Int64);
+        return true;
+
+    case EKind::UInt64:
+        OutNumber = static_cast<double>(Payload.UInt64);
+        return true;
+
+    case EKind::Boolean:
+        OutNumber = Payload.Bool ? 1.0 : 0.0;
+        return true;
+
+    case EKind::String:
+        return ParseWhole(AsStringView(), OutNumber);
+
+    default:
+        return false;
+    }
+}
+
+bool JsonFrozenValue::TryGetNumber(float& OutNumber) const
+{
+    double Double;
+
+    if(TryGetNumber(Double)){
+        OutNumber = static_cast<float>(Double);
+        return true;
+    }
+
+    return false;
+}
+
+bool JsonFrozenValue::TryGetNumber(std::int8_t& OutNumber) const { return TryGetInteger(OutNumber); }
+bool JsonFrozenValue::TryGetNumber(std::int16_t& OutNumber) const { return TryGetInteger(OutNumber); }
+bool JsonFrozenValue::TryGetNumber(std::int32_t& OutNumber) const { return TryGetInteger(OutNumber); }
+bool JsonFrozenValue::TryGetNumber(std::int64_t& OutNumber) const { return TryGetInteger(OutNumber); }
+bool JsonFrozenValue::TryGetNumber(std::uint8_t& OutNumber) const { return TryGetInteger(OutNumber); }
+bool JsonFrozenValue::TryGetNumber(std::uint16_t& OutNumber) const { return TryGetInteger(OutNumber); }
+bool JsonFrozenValue::TryGetNumber(std::uint32_t& OutNumber) const { return TryGetInteger(OutNumber); }
+bool JsonFrozenValue::TryGetNumber(std::uint64_t& OutNumber) const { return TryGetInteger(OutNumber); }
+
+bool JsonFrozenValue::TryGetString(std::string& OutString) const
+{
+    char Buffer[32];
+    std::to_chars_result Result;
+
+    switch (Kind)
+    {
+    case EKind::String:
+        OutString = AsStringView();
+        return true;
+
+    case EKind::Boolean:
+        OutString = Payload.Bool ? "true" : "false";
+        return true;
+
+    case EKind::Double:
+        Result = std::to_chars(Buffer, Buffer + sizeof(Buffer), Payload.Double);
+        break;
+
+    case EKind::Int64:
+        Result = std::to_chars(Buffer, Buffer + sizeof(Buffer), Payload.Int64);
+        break;
+
+    case EKind::UInt64:
+        Result = std::to_chars(Buffer, Buffer + sizeof(Buffer), Payload.UInt64);
+        break;
+
+    default:
+        return false;
+    }
+
+    OutString.assign(Buffer, Result.ptr);
+    return true;
+}
+
+bool JsonFrozenValue::TryGetBool(bool& OutBool) const
+{
+    switch (Kind)
+    {
+    case EKind::Boolean:
+        OutBool = Payload.Bool;
+        return true;
+
+    case EKind::Double:
+    case EKind::Int64:
+    case EKind::UInt64:
+        OutBool = AsNumber() != 0.0;
+        return true;
+
+    case EKind::String:
+    {
+        const std::string_view String = AsStringView();
+        double Number;
+
+        if(ParseWhole(String, Number)){
+            OutBool = Number != 0.0;
+        }else{
+            OutBool = JsonUtils::EqualsIgnoreCase(String, "true") ||
+                JsonUtils::EqualsIgnoreCase(String, "yes") ||
+                JsonUtils::EqualsIgnoreCase(String, "on");
+        }
+
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+const JsonFrozenValue* JsonFrozenValue::TryGetField(std::string_view FieldName) const
+{
+    if(Kind != EKind::Object){
+        return nullptr;
+    }
+
+    const JsonFrozenField* const Begin = Payload.Fields;
+
+    // Later duplicates win, as they do for JsonObject
+    if(Size <= LinearSearchLimit){
+        for(std::size_t i = Size; i-- > 0;){
+            if(Begin[i].GetName() == FieldName){
+                return &Begin[i].Value;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Finds the first field sorting after FieldName; duplicates are sorted stably, so the last match precedes it
+    std::size_t Low = 0;
+    std::size_t High = Size;
+
+    while(Low < High){
+        const std::size_t Middle = Low + (High - Low) / 2;
+
+        if(Begin[Begin[Middle].SortedPosition].GetName() <= FieldName){
+            Low = Middle + 1;
+        }else{
+            High = Middle;
+        }
+    }
+
+    if(Low == 0){
+        return nullptr;
+    }
+
+    const JsonFrozenField& Field = Begin[Begin[Low - 1].SortedPosition];
+
+    return Field.GetName() == FieldName ? &Field.Value : nullptr;
+}
+
+// static
+bool JsonFrozenValue::CompareEqual(const JsonFrozenValue& Lhs, const JsonFrozenValue& Rhs)
+{
+    const EJson Type = Lhs.GetType();
+
+    if(Type != Rhs.GetType()){
+        return false;
+    }
+
+    switch (Type)
+    {
+    case EJson::None:
+    case EJson::Null:
+        return true;
+
+    case EJson::Boolean:
+        return Lhs.Payload.Bool == Rhs.Payload.Bool;
+
+    case EJson::Number:
+    {
+        std::int64_t LhsInt64, RhsInt64;
+        std::uint64_t LhsUInt64, RhsUInt64;
+
+        // Integers are compared exactly, anything else as doubles
+        if(Lhs.Kind != EKind::Double && Rhs.Kind != EKind::Double){
+            if(Lhs.TryGetInteger(LhsInt64) && Rhs.TryGetInteger(RhsInt64)){
+                return LhsInt64 == RhsInt64;
+            }
+
+            if(Lhs.TryGetInteger(LhsUInt64) && Rhs.TryGetInteger(RhsUInt64)){
+                return LhsUInt64 == RhsUInt64;
+            }
+
+            return false;
+        }
+
+        return Lhs.AsNumber() == Rhs.AsNumber();
+    }
+
+    case EJson::String:
+        return Lhs.AsStringView() == Rhs.AsStringView();
+
+    case EJson::Array:
+    {
+        if(Lhs.Size != Rhs.Size){
+            return false;
+        }
+
+        for(std::size_t i = 0; i < Lhs.Size; ++i){
+            if(!CompareEqual(Lhs.Payload.Elements[i], Rhs.Payload.Elements[i])){
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    case EJson::Object:
+    {
+        if(Lhs.Size != Rhs.Size){
+            return false;
+        }
+
+        for(const JsonFrozenField& Field : Lhs.AsObject()){
+            const JsonFrozenValue* RhsValue = Rhs.TryGetField(Field.GetName());
+
+            if(!RhsValue || !CompareEqual(*Lhs.TryGetField(Field.GetName()), *RhsValue)){
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+// static
+std::shared_ptr<const JsonFrozenDocument> JsonFrozenDocument::Create(const JsonValue& Root)
+{
+    std::shared_ptr<JsonFrozenDocument> Document(new JsonFrozenDocument());
+
+    return Document->Build(&Root, nullptr) ? Document : nullptr;
+}
+
+// static
+std::shared_ptr<const JsonFrozenDocument> JsonFrozenDocument::Create(const JsonObject& Root)
+{
+    std::shared_ptr<JsonFrozenDocument> Document(new JsonFrozenDocument());
+
+    return Document->Build(nullptr, &Root) ? Document : nullptr;
+}
+
+bool JsonFrozenDocument::Build(const JsonValue* RootValue, const JsonObject* RootObject)
+{
+    constexpr std::size_t MaxSize = std::numeric_limits<std::uint32_t>::max();
+
+    // Distinct field names, pointing into the source tree until they are copied
+    std::unordered_map<std::string_view, const char*> Names;
+
+    // First pass: size the blocks. Walked with a stack, like the writer, so deep trees don't overflow.
+    std::vector<const JsonObject*> ObjectStack;
+    std::vector<const JsonValue*> ValueStack;
+
+    auto CountValue = [&](const JsonValue* Value)
+    {
+        if(!Value){
+            return true;
+        }
+
+        if(Value->Type == EJson::String){
+            const std::string_view String = static_cast<const JsonValueString*>(Value)->GetString();
+
+            CharacterCount += String.size();
+            return String.size() <= MaxSize;
+        }
+
+        if(Value->Type == EJson::Array || Value->Type == EJson::Object){
+            ValueStack.push_back(Value);
+        }
+
+        return true;
+    };
+
+    auto CountObject = [&](const JsonObject& Object)
+    {
+        FieldCount += Object.Values.size();
+
+        for(const auto& [Name, Value] : Object.Values){
+            const std::string_view NameView = Name.View();
+
+            if(NameView.size() > MaxSize){
+                return false;
+            }
+
+            if(Names.emplace(NameView, nullptr).second){
+                CharacterCount += NameView.size();
+            }
+
+            if(!CountValue(Value.get())){
+                return false;
+            }
+        }
+
+        return Object.Values.size() <= MaxSize;
+    };
+
+    if(RootObject ? !CountObject(*RootObject) : !CountValue(RootValue)){
+        return false;
+    }
+
+    while(!ValueStack.empty()){
+        const JsonValue* Value = ValueStack.back();
+        ValueStack.pop_back();
+
+        const JsonArray* Array;
+        const JsonObject* Object;
+        GetContainer(*Value, Array, Object);
+
+        if(Array){
+            ElementCount += Array->size();
+
+            if(Array->size() > MaxSize){
+                return false;
+            }
+
+            for(const std::shared_ptr<JsonValue>& Element : *Array){
+                if(!CountValue(Element.get())){
+                    return false;
+                }
+            }
+        }else if(Object && !CountObject(*Object)){
+            return false;
+        }
+    }
+
+    Elements.reset(new JsonFrozenValue[ElementCount]);
+    Fields.reset(new JsonFrozenField[FieldCount]);
+    Characters.reset(new char[CharacterCount]);
+
+    std::size_t ElementsUsed = 0;
+    std::size_t FieldsUsed = 0;
+    std::size_t CharactersUsed = 0;
+
+    auto CopyCharacters = [&](const std::string_view String)
+    {
+        char* const Copy = Characters.get() + CharactersUsed;
+
+        std::memcpy(Copy, String.data(), String.size());
+        CharactersUsed += String.size();
+        return Copy;
+    };
+
+    // Second pass: fill the blocks. Containers are only linked here and filled when popped.
+    struct PendingValue
+    {
+        const JsonValue* Source;
+        JsonFrozenValue* Target;
+    };
+
+    std::vector<PendingValue> Pending;
+    std::vector<std::uint32_t> Order;
+
+    auto FreezeObject = [&](const JsonObject& Object, JsonFrozenValue& Target)
+    {
+        JsonFrozenField* const Begin = Fields.get() + FieldsUsed;
+        std::uint32_t Position = 0;
+
+        Target.Kind = JsonFrozenValue::EKind::Object;
+        Target.Size = static_cast<std::uint32_t>(Object.Values.size());
+        Target.Payload.Fields = Begin;
+        FieldsUsed += Object.Values.size();
+
+        for(const auto& [Name, Value] : Object.Values){
+            JsonFrozenField& Field = Begin[Position++];
+            const char*& NameCopy = Names[Name.View()];
+
+            if(!NameCopy){
+                NameCopy = CopyCharacters(Name.View());
+            }
+
+            Field.Name = NameCopy;
+            Field.NameLength = static_cast<std::uint32_t>(Name.View().size());
+            Pending.push_back(PendingValue{Value.get(), &Field.Value});
+        }
+
+        if(Target.Size > LinearSearchLimit){
+            Order.resize(Target.Size);
+
+            for(std::uint32_t i = 0; i < Target.Size; ++i){
+                Order[i] = i;
+            }
+
+            std::stable_sort(Order.begin(), Order.end(), [Begin](const std::uint32_t Lhs, const std::uint32_t Rhs)
+            {
+                return Begin[Lhs].GetName() < Begin[Rhs].GetName();
+            });
+
+            for(std::uint32_t i = 0; i < Target.Size; ++i){
+                Begin[i].SortedPosition = Order[i];
+            }
+        }
+    };
+
+    if(RootObject){
+        FreezeObject(*RootObject, Root);
+    }else{
+        Pending.push_back(PendingValue{RootValue, &Root});
+    }
+
+    while(!Pending.empty()){
+        const auto [Source, Target] = Pending.back();
+        Pending.pop_back();
+
+        if(!Source){
+            Target->Kind = JsonFrozenValue::EKind::Null;
+            continue;
+        }
+
+        switch (Source->Type)
+        {
+        case EJson::Null:
+            Target->Kind = JsonFrozenValue::EKind::Null;
+            break;
+
+        case EJson::Boolean:
+            Target->Kind = JsonFrozenValue::EKind::Boolean;
+            Target->Payload.Bool = Source->AsBool();
+            break;
+
+        case EJson::Number:
+        {
+            const JsonValueNumber* Number = static_cast<const JsonValueNumber*>(Source);
+
+            switch (Number->GetNumberType())
+            {
+            case EJsonNumber::Int64:
+                Target->Kind = JsonFrozenValue::EKind::Int64;
+                Number->TryGetNumber(Target->Payload.Int64);
+                break;
+
+            case EJsonNumber::UInt64:
+                Target->Kind = JsonFrozenValue::EKind::UInt64;
+                Number->TryGetNumber(Target->Payload.UInt64);
+                break;
+
+            default:
+                Target->Kind = JsonFrozenValue::EKind::Double;
+                Number->TryGetNumber(Target->Payload.Double);
+                break;
+            }
+
+            break;
+        }
+
+        case EJson::String:
+        {
+            const std::string_view String = static_cast<const JsonValueString*>(Source)->GetString();
+
+            Target->Kind = JsonFrozenValue::EKind::String;
+            Target->Size = static_cast<std::uint32_t>(String.size());
+            Target->Payload.String = CopyCharacters(String);
+            break;
+        }
+
+        case EJson::Array:
+        case EJson::Object:
+        {
+            const JsonArray* Array;
+            const JsonObject* Object;
+            GetContainer(*Source, Array, Object);
+
+            if(Array){
+                JsonFrozenValue* const Begin = Elements.get() + ElementsUsed;
+
+                Target->Kind = JsonFrozenValue::EKind::Array;
+                Target->Size = static_cast<std::uint32_t>(Array->size());
+                Target->Payload.Elements = Begin;
+                ElementsUsed += Array->size();
+
+                for(std::size_t i = 0; i < Array->size(); ++i){
+                    Pending.push_back(PendingValue{(*Array)[i].get(), Begin + i});
+                }
+            }else if(Object){
+                FreezeObject(*Object, *Target);
+            }else{
+                // Matches the writer, which prints an object without a JsonObject as null
+                Target->Kind = JsonFrozenValue::EKind::Null;
+            }
+
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,163 @@
+#include "Domain/JsonLazyValue.hpp"
+#include "Serialization/JsonReader.hpp"
+
+using namespace zexjson;
+
+namespace{
+
+/** Reads a range of text and tells where in it the reader is */
+class JsonRangeReader : public JsonStringViewReader
+{
+public:
+    explicit JsonRangeReader(const std::string_view Text) :
+        JsonStringViewReader(Text)
+        {}
+
+    inline const char* GetPosition() const { return Cursor; }
+};
+
+std::shared_ptr<JsonValue> MakeNumber(const JsonRangeReader& Reader)
+{
+    switch (Reader.GetValueNumberType())
+    {
+    case EJsonNumber::Int64:
+        return std::make_shared<JsonValueNumber>(Reader.GetValueAsInt64());
+
+    case EJsonNumber::UInt64:
+        return std::make_shared<JsonValueNumber>(Reader.GetValueAsUInt64());
+
+    default:
+        return std::make_shared<JsonValueNumber>(Reader.GetValueAsNumber());
+    }
+}
+
+} // namespace
+
+// static
+std::shared_ptr<JsonValue> JsonValueLazy::Create(std::string_view Text, std::shared_ptr<const void> Owner)
+{
+    const std::size_t Start = Text.find_first_not_of(" \t\r\n");
+
+    if(Start == std::string_view::npos){
+        return nullptr;
+    }
+
+    Text.remove_prefix(Start);
+
+    if(Text[0] == '{'){
+        return std::make_shared<JsonValueLazy>(EJson::Object, Text, std::move(Owner));
+    }
+
+    if(Text[0] == '['){
+        return std::make_shared<JsonValueLazy>(EJson::Array, Text, std::move(Owner));
+    }
+
+    return nullptr;
+}
+
+JsonValueLazy::JsonValueLazy(EJson InType, std::string_view InText, std::shared_ptr<const void> InOwner) :
+    Text(InText), Owner(std::move(InOwner)), Object(), Array(), State(EState::Pending)
+{
+    Type = InType;
+}
+
+bool JsonValueLazy::TryGetArray(const JsonArray*& OutArray) const
+{
+    if(Type != EJson::Array){
+        return false;
+    }
+
+    if(State == EState::Pending){
+        Materialize();
+    }
+
+    OutArray = &Array;
+    return State == EState::Ready;
+}
+
+bool JsonValueLazy::TryGetObject(const std::shared_ptr<JsonObject>*& OutObject) const
+{
+    if(Type != EJson::Object){
+        return false;
+    }
+
+    if(State == EState::Pending){
+        Materialize();
+    }
+
+    OutObject = &Object;
+    return State == EState::Ready;
+}
+
+void JsonValueLazy::Materialize() const
+{
+    JsonRangeReader Reader(Text);
+    EJsonNotation Notation;
+
+    State = EState::Failed;
+
+    if(!Reader.ReadNext(Notation) || (Notation != EJsonNotation::ObjectStart && Notation != EJsonNotation::ArrayStart)){
+        return;
+    }
+
+    std::shared_ptr<JsonObject> NewObject = Type == EJson::Object ? std::make_shared<JsonObject>() : nullptr;
+    JsonArray NewArray;
+
+    while(Reader.ReadNext(Notation)){
+        std::shared_ptr<JsonValue> NewValue;
+
+        // Taken before skipping a container, which moves the reader past its own fields
+        JsonName Identifier = NewObject ? JsonName(Reader.GetIdentifierView()) : JsonName();
+
+        switch (Notation)
+        {
+        case EJsonNotation::ObjectEnd:
+        case EJsonNotation::ArrayEnd:
+            Object = std::move(NewObject);
+            Array = std::move(NewArray);
+            State = EState::Ready;
+            return;
+
+        case EJsonNotation::ObjectStart:
+        case EJsonNotation::ArrayStart:
+        {
+            // The opening bracket was the last character read
+            const char* const Begin = Reader.GetPosition() - 1;
+            const bool bObject = Notation == EJsonNotation::ObjectStart;
+
+            if(!(bObject ? Reader.SkipObject() : Reader.SkipArray())){
+                return;
+            }
+
+            const std::string_view Member(Begin, Reader.GetPosition() - Begin);
+            NewValue = std::make_shared<JsonValueLazy>(bObject ? EJson::Object : EJson::Array, Member, Owner);
+            break;
+        }
+
+        case EJsonNotation::String:
+            NewValue = std::make_shared<JsonValueString>(Reader.GetValueAsStringView());
+            break;
+
+        case EJsonNotation::Number:
+            NewValue = MakeNumber(Reader);
+            break;
+
+        case EJsonNotation::Boolean:
+            NewValue = std::make_shared<JsonValueBoolean>(Reader.GetValueAsBoolean());
+            break;
+
+        case EJsonNotation::Null:
+            NewValue = std::make_shared<JsonValueNull>();
+            break;
+
+        case EJsonNotation::Error:
+            return;
+        }
+
+        if(NewObject){
+            NewObject->Values.insert_or_assign(std::move(Identifier), std::move(NewValue));
+        }else{
+            NewArray.push_back(std::move(NewValue));
+        }
+    }
+}
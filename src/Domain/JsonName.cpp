@@ -0,0 +1,75 @@
+#include "Domain/JsonName.hpp"
+
+#include <cstddef>
+
+using namespace zexjson;
+
+JsonName::JsonName(const std::string_view InName) :
+    Storage{}, Kind(EKind::Inline)
+{
+    SetName(InName);
+}
+
+JsonName::JsonName(const JsonName& Other) :
+    Storage{}, Kind(EKind::Inline)
+{
+    // An interned copy would refer to a pool the copy may outlive, so only moves keep sharing it
+    if(Other.Kind == EKind::Inline){
+        std::memcpy(Storage, Other.Storage, sizeof(Storage));
+    }else{
+        SetName(Other.View());
+    }
+}
+
+JsonName::JsonName(JsonName&& Other) noexcept :
+    Kind(Other.Kind)
+{
+    std::memcpy(Storage, Other.Storage, sizeof(Storage));
+    Other.Kind = EKind::Inline;
+    Other.Storage[InlineCapacity] = 0;
+}
+
+JsonName& JsonName::operator=(const JsonName& Other)
+{
+    if(this != &Other){
+        JsonName Copy(Other);
+        *this = std::move(Copy);
+    }
+
+    return *this;
+}
+
+JsonName& JsonName::operator=(JsonName&& Other) noexcept
+{
+    if(this != &Other){
+        this->~JsonName();
+
+        std::memcpy(Storage, Other.Storage, sizeof(Storage));
+        Kind = Other.Kind;
+
+        Other.Kind = EKind::Inline;
+        Other.Storage[InlineCapacity] = 0;
+    }
+
+    return *this;
+}
+
+void JsonName::SetName(const std::string_view InName)
+{
+    if(InName.size() <= InlineCapacity){
+        if(!InName.empty()){
+            std::memcpy(Storage, InName.data(), InName.size());
+        }
+
+        Storage[InlineCapacity] = static_cast<char>(InName.size());
+        Kind = EKind::Inline;
+        return;
+    }
+
+    Record* Name = static_cast<Record*>(::operator new(offsetof(Record, Chars) + InName.size()));
+    Name->Length = InName.size();
+    std::memcpy(Name->Chars, InName.data(), InName.size());
+
+    std::memcpy(Storage, &Name, sizeof(Name));
+    Kind = EKind::Owned;
+}
@@ -0,0 +1,46 @@
+#include "Domain/JsonNamePool.hpp"
+
+#include <cstddef>
+
+using namespace zexjson;
+
+JsonNamePool::~JsonNamePool()
+{
+    for(const std::pair<char*, std::size_t>& Block : Blocks){
+        Resource->deallocate(Block.first, Block.second, alignof(JsonName::Record));
+    }
+}
+
+JsonName JsonNamePool::Intern(std::string_view Name)
+{
+    // Short names are stored in place, which is cheaper than sharing them
+    if(Name.size() <= JsonName::InlineCapacity){
+        return JsonName(Name);
+    }
+
+    const auto NameIt = Names.find(Name);
+    if(NameIt != Names.end()){
+        return JsonName(*NameIt);
+    }
+
+    const std::size_t Alignment = alignof(JsonName::Record);
+    const std::size_t Size = (offsetof(JsonName::Record, Chars) + Name.size() + Alignment - 1) & ~(Alignment - 1);
+
+    if(Size > Remaining){
+        const std::size_t BlockSize = std::max(Size, DefaultBlockSize);
+        Cursor = static_cast<char*>(Resource->allocate(BlockSize, alignof(JsonName::Record)));
+        Blocks.emplace_back(Cursor, BlockSize);
+        Remaining = BlockSize;
+    }
+
+    JsonName::Record* Pooled = reinterpret_cast<JsonName::Record*>(Cursor);
+    Pooled->Length = Name.size();
+    std::memcpy(Pooled->Chars, Name.data(), Name.size());
+
+    Cursor += Size;
+    Remaining -= Size;
+    ByteSize += Size;
+
+    Names.insert(Pooled);
+    return JsonName(Pooled);
+}
@@ -2,52 +2,78 @@
 
 using namespace zexjson;
 
-void JsonObject::SetField(const std::string& FieldName, const std::shared_ptr<JsonValue>& Value)
+void JsonObject::SetField(const JsonKey& FieldName, const std::shared_ptr<JsonValue>& Value)
 {
     this->Values[FieldName] = Value;
 }
 
-void JsonObject::RemoveField(const std::string& FieldName)
+void JsonObject::RemoveField(const JsonKey& FieldName)
 {
     this->Values.erase(FieldName);
 }
 
-double JsonObject::GetNumberField(const std::string& FieldName) const
+double JsonObject::GetNumberField(const JsonKey& FieldName) const
 {
-    return GetField<EJson::None>(FieldName)->AsNumber();
+    const JsonValue* Field = FindField(FieldName);
+    return Field ? Field->AsNumber() : 0.0;
 }
 
-bool JsonObject::TryGetNumberField(const std::string& FieldName, double& OutNumber) const
+bool JsonObject::TryGetNumberField(const JsonKey& FieldName, double& OutNumber) const
 {
-    auto Field = TryGetField(FieldName);
+    const JsonValue* Field = FindField(FieldName);
     return Field && Field->TryGetNumber(OutNumber);
 }
 
-void JsonObject::SetNumberField(const std::string& FieldName, double Number)
+bool JsonObject::TryGetNumberField(const JsonKey& FieldName, std::int32_t& OutNumber) const
 {
-    this->Values[FieldName] = std::make_shared<JsonValueNumber>(Number);
+    const JsonValue* Field = FindField(FieldName);
+    return Field && Field->TryGetNumber(OutNumber);
+}
+
+bool JsonObject::TryGetNumberField(const JsonKey& FieldName, std::uint32_t& OutNumber) const
+{
+    const JsonValue* Field = FindField(FieldName);
+    return Field && Field->TryGetNumber(OutNumber);
+}
+
+bool JsonObject::TryGetNumberField(const JsonKey& FieldName, std::int64_t& OutNumber) const
+{
+    const JsonValue* Field = FindField(FieldName);
+    return Field && Field->TryGetNumber(OutNumber);
+}
+
+bool JsonObject::TryGetNumberField(const JsonKey& FieldName, std::uint64_t& OutNumber) const
+{
+    const JsonValue* Field = FindField(FieldName);
+    return Field && Field->TryGetNumber(OutNumber);
+}
+
+void JsonObject::SetNumberField(const JsonKey& FieldName, double Number)
+{
+    SetField(FieldName, std::make_shared<JsonValueNumber>(Number));
 }
 
-std::string JsonObject::GetStringField(const std::string& FieldName) const
+std::string JsonObject::GetStringField(const JsonKey& FieldName) const
 {
-    return GetField<EJson::None>(FieldName)->AsString();
+    const JsonValue* Field = FindField(FieldName);
+    return Field ? Field->AsString() : std::string();
 }
 
-bool JsonObject::TryGetStringField(const std::string& FieldName, std::string& OutString) const
+bool JsonObject::TryGetStringField(const JsonKey& FieldName, std::string& OutString) const
 {
-    auto Field = TryGetField(FieldName);
+    const JsonValue* Field = FindField(FieldName);
     return Field && Field->TryGetString(OutString);
 }
 
-bool JsonObject::TryGetStringArrayField(const std::string& FieldName, std::vector<std::string>& OutArray) const
+bool JsonObject::TryGetStringArrayField(const JsonKey& FieldName, std::vector<std::string>& OutArray) const
 {
-    auto Field = TryGetField(FieldName);
+    const JsonValue* Field = FindField(FieldName);
 
     if(!Field){
         return false;
     }
 
-    const std::vector<std::shared_ptr<JsonValue>>* Array;
+    const JsonArray* Array;
 
     if(!Field->TryGetArray(Array)){
         return false;
@@ -66,59 +92,60 @@ bool JsonObject::TryGetStringArrayField(const std::string& FieldName, std::vecto
     return true;
 }
 
-void JsonObject::SetStringField(const std::string& FieldName, const std::string& StringValue)
+void JsonObject::SetStringField(const JsonKey& FieldName, const std::string& StringValue)
 {
-    this->Values[FieldName] = std::make_shared<JsonValueString>(StringValue);
+    SetField(FieldName, std::make_shared<JsonValueString>(StringValue));
 }
 
-bool JsonObject::GetBoolField(const std::string& FieldName) const
+bool JsonObject::GetBoolField(const JsonKey& FieldName) const
 {
-    return GetField<EJson::None>(FieldName)->AsBool();
+    const JsonValue* Field = FindField(FieldName);
+    return Field ? Field->AsBool() : false;
 }
 
-bool JsonObject::TryGetBoolField(const std::string& FieldName, bool& OutBool) const
+bool JsonObject::TryGetBoolField(const JsonKey& FieldName, bool& OutBool) const
 {
-    auto Field = TryGetField(FieldName);
+    const JsonValue* Field = FindField(FieldName);
     return Field && Field->TryGetBool(OutBool);
 }
 
-void JsonObject::SetBoolField(const std::string& FieldName, bool InValue)
+void JsonObject::SetBoolField(const JsonKey& FieldName, bool InValue)
 {
-    this->Values[FieldName] = std::make_shared<JsonValueBoolean>(InValue);
+    SetField(FieldName, std::make_shared<JsonValueBoolean>(InValue));
 }
 
-const std::vector<std::shared_ptr<JsonValue>>& JsonObject::GetArrayField(const std::string& FieldName) const
+const JsonArray& JsonObject::GetArrayField(const JsonKey& FieldName) const
 {
     return GetField<EJson::Array>(FieldName)->AsArray();
 }
 
-bool JsonObject::TryGetArrayField(const std::string& FieldName, const std::vector<std::shared_ptr<JsonValue>>*& OutArray) const
+bool JsonObject::TryGetArrayField(const JsonKey& FieldName, const JsonArray*& OutArray) const
 {
-    auto Field = TryGetField(FieldName);
+    const JsonValue* Field = FindField(FieldName);
     return Field && Field->TryGetArray(OutArray);
 }
 
-void JsonObject::SetArrayField(const std::string& FieldName, const std::vector<std::shared_ptr<JsonValue>>& Array)
+void JsonObject::SetArrayField(const JsonKey& FieldName, const JsonArray& Array)
 {
-    this->Values[FieldName] = std::make_shared<JsonValueArray>(Array);
+    SetField(FieldName, std::make_shared<JsonValueArray>(Array));
 }
 
-const std::shared_ptr<JsonObject>& JsonObject::GetObjectField(const std::string& FieldName) const
+const std::shared_ptr<JsonObject>& JsonObject::GetObjectField(const JsonKey& FieldName) const
 {
     return GetField<EJson::Object>(FieldName)->AsObject();
 }
 
-bool JsonObject::TryGetObjectField(const std::string& FieldName, const std::shared_ptr<JsonObject>*& OutObject) const
+bool JsonObject::TryGetObjectField(const JsonKey& FieldName, const std::shared_ptr<JsonObject>*& OutObject) const
 {
-    auto Field = TryGetField(FieldName);
+    const JsonValue* Field = FindField(FieldName);
     return Field && Field->TryGetObject(OutObject);
 }
 
-void JsonObject::SetObjectField(const std::string& FieldName, const std::shared_ptr<JsonObject>& JsonObject)
+void JsonObject::SetObjectField(const JsonKey& FieldName, const std::shared_ptr<JsonObject>& JsonObject)
 {
     if(JsonObject){
-        this->Values[FieldName] = std::make_shared<JsonValueObject>(JsonObject.get());
+        SetField(FieldName, std::make_shared<JsonValueObject>(JsonObject));
     }else{
-        this->Values[FieldName] = std::make_shared<JsonValueNull>();
+        SetField(FieldName, std::make_shared<JsonValueNull>());
     }
 }
\ No newline at end of file
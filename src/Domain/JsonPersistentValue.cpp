@@ -0,0 +1,811 @@
+#include "Domain/JsonPersistentValue.hpp"
+
+#include <algorithm>
+#include <bit>
+
+using namespace zexjson;
+
+namespace zexjson{
+
+/** A field of a persistent object */
+struct JsonPersistentEntry
+{
+    JsonName Name;
+    std::size_t Hash;
+
+    /** Order the field was added in */
+    std::uint64_t Sequence;
+
+    JsonPersistentValue Value;
+};
+
+/**
+ * A node of an object or array trie.
+ *
+ * Object nodes use five bits of the name hash per level. A bit set in
+ * DataMap means a field sits at that slot, stored in Entries; a bit set in
+ * NodeMap means the slot leads to a child node in Children. Both lists are
+ * kept in slot order, so a slot's position is the number of lower bits set.
+ * Once the hash bits run out, a node simply lists the colliding fields.
+ *
+ * Array nodes use five bits of the index per level: inner nodes only have
+ * Children and leaves only have Elements, every node but the rightmost ones
+ * being full.
+*/
+struct JsonPersistentNode
+{
+    std::uint32_t DataMap = 0;
+    std::uint32_t NodeMap = 0;
+    std::vector<JsonPersistentEntry> Entries;
+    std::vector<std::shared_ptr<const JsonPersistentNode>> Children;
+    std::vector<JsonPersistentValue> Elements;
+
+    inline bool IsEmpty() const { return Entries.empty() && Children.empty() && Elements.empty(); }
+};
+
+} // namespace zexjson
+
+namespace{
+
+using NodePtr = std::shared_ptr<const JsonPersistentNode>;
+
+constexpr std::uint32_t BitsPerLevel = 5;
+constexpr std::uint32_t SlotMask = (1u << BitsPerLevel) - 1;
+constexpr std::size_t NodeWidth = std::size_t{1} << BitsPerLevel;
+
+/** Shift at which an object node has no hash bits left and lists collisions instead */
+constexpr std::uint32_t HashBits = std::numeric_limits<std::size_t>::digits;
+
+inline std::uint32_t SlotBit(const std::size_t Hash, const std::uint32_t Shift)
+{
+    return 1u << ((Hash >> Shift) & SlotMask);
+}
+
+/** Returns the position of a slot among those set in Map */
+inline std::size_t SlotPosition(const std::uint32_t Map, const std::uint32_t Bit)
+{
+    return static_cast<std::size_t>(std::popcount(Map & (Bit - 1)));
+}
+
+/**
+ * Returns a node that may be modified: the node itself while a tree is being
+ * built and owned by nobody else, otherwise a copy that replaces it in Node.
+*/
+JsonPersistentNode& MakeWritable(NodePtr& Node, const bool bOwned)
+{
+    if(!bOwned){
+        std::shared_ptr<JsonPersistentNode> Copy = std::make_shared<JsonPersistentNode>(*Node);
+        JsonPersistentNode& Writable = *Copy;
+
+        Node = std::move(Copy);
+        return Writable;
+    }
+
+    return const_cast<JsonPersistentNode&>(*Node);
+}
+
+/** Builds the subtree holding two fields whose hashes agree up to Shift */
+NodePtr MergeEntries(JsonPersistentEntry&& First, JsonPersistentEntry&& Second, const std::uint32_t Shift)
+{
+    std::shared_ptr<JsonPersistentNode> Node = std::make_shared<JsonPersistentNode>();
+
+    if(Shift >= HashBits){
+        Node->Entries.push_back(std::move(First));
+        Node->Entries.push_back(std::move(Second));
+        return Node;
+    }
+
+    const std::uint32_t FirstBit = SlotBit(First.Hash, Shift);
+    const std::uint32_t SecondBit = SlotBit(Second.Hash, Shift);
+
+    if(FirstBit == SecondBit){
+        Node->NodeMap = FirstBit;
+        Node->Children.push_back(MergeEntries(std::move(First), std::move(Second), Shift + BitsPerLevel));
+        return Node;
+    }
+
+    Node->DataMap = FirstBit | SecondBit;
+
+    if(FirstBit < SecondBit){
+        Node->Entries.push_back(std::move(First));
+        Node->Entries.push_back(std::move(Second));
+    }else{
+        Node->Entries.push_back(std::move(Second));
+        Node->Entries.push_back(std::move(First));
+    }
+
+    return Node;
+}
+
+const JsonPersistentValue* FindField(const JsonPersistentNode* Node, const JsonKey& FieldName)
+{
+    const std::size_t Hash = FieldName.GetHash();
+
+    for(std::uint32_t Shift = 0; Node; Shift += BitsPerLevel){
+        if(Shift >= HashBits){
+            for(const JsonPersistentEntry& Entry : Node->Entries){
+                if(Entry.Name.View() == FieldName.GetName()){
+                    return &Entry.Value;
+                }
+            }
+
+            return nullptr;
+        }
+
+        const std::uint32_t Bit = SlotBit(Hash, Shift);
+
+        if(Node->DataMap & Bit){
+            const JsonPersistentEntry& Entry = Node->Entries[SlotPosition(Node->DataMap, Bit)];
+
+            return Entry.Hash == Hash && Entry.Name.View() == FieldName.GetName() ? &Entry.Value : nullptr;
+        }
+
+        if(!(Node->NodeMap & Bit)){
+            return nullptr;
+        }
+
+        Node = Node->Children[SlotPosition(Node->NodeMap, Bit)].get();
+    }
+
+    return nullptr;
+}
+
+/**
+ * Puts a field into the subtree at Node, replacing the value of a field with the same name.
+ *
+ * @return @c true if the field is new, @c false if it replaced one.
+*/
+bool InsertField(NodePtr& Node, JsonPersistentEntry&& NewEntry, const std::uint32_t Shift, const bool bOwned)
+{
+    if(!Node){
+        std::shared_ptr<JsonPersistentNode> Leaf = std::make_shared<JsonPersistentNode>();
+
+        if(Shift < HashBits){
+            Leaf->DataMap = SlotBit(NewEntry.Hash, Shift);
+        }
+
+        Leaf->Entries.push_back(std::move(NewEntry));
+        Node = std::move(Leaf);
+        return true;
+    }
+
+    if(Shift >= HashBits){
+        for(std::size_t i = 0; i < Node->Entries.size(); ++i){
+            if(Node->Entries[i].Name.View() == NewEntry.Name.View()){
+                MakeWritable(Node, bOwned).Entries[i].Value = std::move(NewEntry.Value);
+                return false;
+            }
+        }
+
+        MakeWritable(Node, bOwned).Entries.push_back(std::move(NewEntry));
+        return true;
+    }
+
+    const std::uint32_t Bit = SlotBit(NewEntry.Hash, Shift);
+
+    if(Node->DataMap & Bit){
+        const std::size_t Position = SlotPosition(Node->DataMap, Bit);
+        const JsonPersistentEntry& Existing = Node->Entries[Position];
+
+        if(Existing.Hash == NewEntry.Hash && Existing.Name.View() == NewEntry.Name.View()){
+            MakeWritable(Node, bOwned).Entries[Position].Value = std::move(NewEntry.Value);
+            return false;
+        }
+
+        // Two fields share the slot: push both one level down
+        JsonPersistentNode& Writable = MakeWritable(Node, bOwned);
+        JsonPersistentEntry Displaced = std::move(Writable.Entries[Position]);
+
+        Writable.Entries.erase(Writable.Entries.begin() + Position);
+        Writable.DataMap &= ~Bit;
+        Writable.Children.insert(Writable.Children.begin() + SlotPosition(Writable.NodeMap, Bit),
+            MergeEntries(std::move(Displaced), std::move(NewEntry), Shift + BitsPerLevel));
+        Writable.NodeMap |= Bit;
+        return true;
+    }
+
+    JsonPersistentNode& Writable = MakeWritable(Node, bOwned);
+
+    if(Writable.NodeMap & Bit){
+        return InsertField(Writable.Children[SlotPosition(Writable.NodeMap, Bit)], std::move(NewEntry), Shift + BitsPerLevel, bOwned);
+    }
+
+    Writable.Entries.insert(Writable.Entries.begin() + SlotPosition(Writable.DataMap, Bit), std::move(NewEntry));
+    Writable.DataMap |= Bit;
+    return true;
+}
+
+/**
+ * Takes a field out of the subtree at Node, which becomes @c nullptr once empty.
+ *
+ * A child left with a single field and no children of its own is folded
+ * into its parent, so a trie has the same shape however it was built.
+ *
+ * @return @c true if the field was found.
+*/
+bool EraseField(NodePtr& Node, const JsonKey& FieldName, const std::uint32_t Shift)
+{
+    if(!Node){
+        return false;
+    }
+
+    if(Shift >= HashBits){
+        for(std::size_t i = 0; i < Node->Entries.size(); ++i){
+            if(Node->Entries[i].Name.View() == FieldName.GetName()){
+                JsonPersistentNode& Writable = MakeWritable(Node, false);
+
+                Writable.Entries.erase(Writable.Entries.begin() + i);
+
+                if(Writable.IsEmpty()){
+                    Node.reset();
+                }
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    const std::uint32_t Bit = SlotBit(FieldName.GetHash(), Shift);
+
+    if(Node->DataMap & Bit){
+        const std::size_t Position = SlotPosition(Node->DataMap, Bit);
+        const JsonPersistentEntry& Existing = Node->Entries[Position];
+
+        if(Existing.Hash != FieldName.GetHash() || Existing.Name.View() != FieldName.GetName()){
+            return false;
+        }
+
+        JsonPersistentNode& Writable = MakeWritable(Node, false);
+
+        Writable.Entries.erase(Writable.Entries.begin() + Position);
+        Writable.DataMap &= ~Bit;
+
+        if(Writable.IsEmpty()){
+            Node.reset();
+        }
+
+        return true;
+    }
+
+    if(!(Node->NodeMap & Bit)){
+        return false;
+    }
+
+    const std::size_t ChildPosition = SlotPosition(Node->NodeMap, Bit);
+    NodePtr Child = Node->Children[ChildPosition];
+
+    if(!EraseField(Child, FieldName, Shift + BitsPerLevel)){
+        return false;
+    }
+
+    JsonPersistentNode& Writable = MakeWritable(Node, false);
+
+    if(Child && (!Child->Children.empty() || Child->Entries.size() > 1)){
+        Writable.Children[ChildPosition] = std::move(Child);
+        return true;
+    }
+
+    Writable.Children.erase(Writable.Children.begin() + ChildPosition);
+    Writable.NodeMap &= ~Bit;
+
+    if(Child){
+        Writable.Entries.insert(Writable.Entries.begin() + SlotPosition(Writable.DataMap, Bit), Child->Entries.front());
+        Writable.DataMap |= Bit;
+    }else if(Writable.IsEmpty()){
+        Node.reset();
+    }
+
+    return true;
+}
+
+void CollectFields(const JsonPersistentNode* Node, std::vector<const JsonPersistentEntry*>& OutEntries)
+{
+    for(const JsonPersistentEntry& Entry : Node->Entries){
+        OutEntries.push_back(&Entry);
+    }
+
+    for(const NodePtr& Child : Node->Children){
+        CollectFields(Child.get(), OutEntries);
+    }
+}
+
+/** Builds an array trie over Values, returning its top node and setting OutShift */
+NodePtr BuildArray(std::vector<JsonPersistentValue>&& Values, std::uint32_t& OutShift)
+{
+    std::vector<NodePtr> Level;
+    Level.reserve((Values.size() + NodeWidth - 1) / NodeWidth);
+
+    for(std::size_t First = 0; First < Values.size(); First += NodeWidth){
+        std::shared_ptr<JsonPersistentNode> Leaf = std::make_shared<JsonPersistentNode>();
+        const std::size_t Last = std::min(First + NodeWidth, Values.size());
+
+        Leaf->Elements.assign(std::make_move_iterator(Values.begin() + First), std::make_move_iterator(Values.begin() + Last));
+        Level.push_back(std::move(Leaf));
+    }
+
+    OutShift = 0;
+
+    while(Level.size() > 1){
+        std::vector<NodePtr> Parents;
+        Parents.reserve((Level.size() + NodeWidth - 1) / NodeWidth);
+
+        for(std::size_t First = 0; First < Level.size(); First += NodeWidth){
+            std::shared_ptr<JsonPersistentNode> Parent = std::make_shared<JsonPersistentNode>();
+            const std::size_t Last = std::min(First + NodeWidth, Level.size());
+
+            Parent->Children.assign(std::make_move_iterator(Level.begin() + First), std::make_move_iterator(Level.begin() + Last));
+            Parents.push_back(std::move(Parent));
+        }
+
+        Level = std::move(Parents);
+        OutShift += BitsPerLevel;
+    }
+
+    return Level.empty() ? nullptr : Level.front();
+}
+
+/** Returns a chain of nodes down to a leaf holding only Value */
+NodePtr NewPath(const std::uint32_t Shift, const JsonPersistentValue& Value)
+{
+    std::shared_ptr<JsonPersistentNode> Node = std::make_shared<JsonPersistentNode>();
+
+    if(Shift == 0){
+        Node->Elements.push_back(Value);
+    }else{
+        Node->Children.push_back(NewPath(Shift - BitsPerLevel, Value));
+    }
+
+    return Node;
+}
+
+void AssignElement(NodePtr& Node, const std::uint32_t Shift, const std::size_t Index, const JsonPersistentValue& Value)
+{
+    JsonPersistentNode& Writable = MakeWritable(Node, false);
+
+    if(Shift == 0){
+        Writable.Elements[Index & SlotMask] = Value;
+    }else{
+        AssignElement(Writable.Children[(Index >> Shift) & SlotMask], Shift - BitsPerLevel, Index, Value);
+    }
+}
+
+/** Appends Value as element Index of a trie that has room for it */
+void AppendElement(NodePtr& Node, const std::uint32_t Shift, const std::size_t Index, const JsonPersistentValue& Value)
+{
+    JsonPersistentNode& Writable = MakeWritable(Node, false);
+
+    if(Shift == 0){
+        Writable.Elements.push_back(Value);
+        return;
+    }
+
+    const std::size_t Slot = (Index >> Shift) & SlotMask;
+
+    if(Slot < Writable.Children.size()){
+        AppendElement(Writable.Children[Slot], Shift - BitsPerLevel, Index, Value);
+    }else{
+        Writable.Children.push_back(NewPath(Shift - BitsPerLevel, Value));
+    }
+}
+
+/** Removes element Index, the last one, from a trie; Node becomes @c nullptr once empty */
+void RemoveLastElement(NodePtr& Node, const std::uint32_t Shift, const std::size_t Index)
+{
+    JsonPersistentNode& Writable = MakeWritable(Node, false);
+
+    if(Shift == 0){
+        Writable.Elements.pop_back();
+    }else{
+        NodePtr& Child = Writable.Children[(Index >> Shift) & SlotMask];
+
+        RemoveLastElement(Child, Shift - BitsPerLevel, Index);
+
+        if(!Child){
+            Writable.Children.pop_back();
+        }
+    }
+
+    if(Writable.IsEmpty()){
+        Node.reset();
+    }
+}
+
+} // namespace
+
+JsonPersistentValue::JsonPersistentValue() :
+    Type(EJson::Null), Shift(0), Size(0), NextSequence(0)
+{}
+
+JsonPersistentValue::JsonPersistentValue(const std::shared_ptr<const JsonValue>& Value) :
+    JsonPersistentValue()
+{
+    if(!Value){
+        return;
+    }
+
+    switch (Value->Type)
+    {
+    case EJson::String:
+    case EJson::Number:
+    case EJson::Boolean:
+        Type = Value->Type;
+        Scalar = Value;
+        break;
+
+    case EJson::Array:
+    {
+        const JsonArray* Array;
+
+        if(Value->TryGetArray(Array)){
+            std::vector<JsonPersistentValue> Elements(Array->begin(), Array->end());
+
+            Type = EJson::Array;
+            Size = Elements.size();
+            Root = BuildArray(std::move(Elements), Shift);
+        }
+
+        break;
+    }
+
+    case EJson::Object:
+    {
+        const std::shared_ptr<JsonObject>* Object;
+
+        if(Value->TryGetObject(Object) && *Object){
+            *this = JsonPersistentValue(**Object);
+        }
+
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+JsonPersistentValue::JsonPersistentValue(const JsonObject& Object) :
+    JsonPersistentValue()
+{
+    Type = EJson::Object;
+
+    // Every node is new and owned by this value alone, so fields are inserted in place
+    for(const auto& [Name, Value] : Object.Values){
+        const std::size_t Hash = JsonKey::HashName(Name.View());
+
+        if(InsertField(Root, JsonPersistentEntry{Name, Hash, NextSequence, JsonPersistentValue(Value)}, 0, true)){
+            ++NextSequence;
+            ++Size;
+        }
+    }
+}
+
+// static
+JsonPersistentValue JsonPersistentValue::MakeObject()
+{
+    JsonPersistentValue Object;
+    Object.Type = EJson::Object;
+    return Object;
+}
+
+// static
+JsonPersistentValue JsonPersistentValue::MakeArray()
+{
+    JsonPersistentValue Array;
+    Array.Type = EJson::Array;
+    return Array;
+}
+
+const JsonPersistentValue* JsonPersistentValue::TryGetField(const JsonKey& FieldName) const
+{
+    return Type == EJson::Object ? FindField(Root.get(), FieldName) : nullptr;
+}
+
+JsonPersistentValue JsonPersistentValue::SetField(const JsonKey& FieldName, const JsonPersistentValue& Value) const
+{
+    JsonPersistentValue Version = *this;
+
+    if(Type == EJson::Object &&
+        InsertField(Version.Root, JsonPersistentEntry{FieldName.GetName(), FieldName.GetHash(), NextSequence, Value}, 0, false)){
+        ++Version.NextSequence;
+        ++Version.Size;
+    }
+
+    return Version;
+}
+
+JsonPersistentValue JsonPersistentValue::RemoveField(const JsonKey& FieldName) const
+{
+    JsonPersistentValue Version = *this;
+
+    if(Type == EJson::Object && EraseField(Version.Root, FieldName, 0)){
+        --Version.Size;
+    }
+
+    return Version;
+}
+
+void JsonPersistentValue::GetFields(FieldList& OutFields) const
+{
+    OutFields.clear();
+
+    if(Type != EJson::Object || !Root){
+        return;
+    }
+
+    std::vector<const JsonPersistentEntry*> Entries;
+    Entries.reserve(Size);
+    CollectFields(Root.get(), Entries);
+
+    std::sort(Entries.begin(), Entries.end(), [](const JsonPersistentEntry* Lhs, const JsonPersistentEntry* Rhs)
+    {
+        return Lhs->Sequence < Rhs->Sequence;
+    });
+
+    OutFields.reserve(Entries.size());
+
+    for(const JsonPersistentEntry* Entry : Entries){
+        OutFields.emplace_back(Entry->Name.View(), &Entry->Value);
+    }
+}
+
+const JsonPersistentValue* JsonPersistentValue::GetElement(const std::size_t Index) const
+{
+    if(Type != EJson::Array || Index >= Size){
+        return nullptr;
+    }
+
+    const JsonPersistentNode* Node = Root.get();
+
+    for(std::uint32_t Level = Shift; Level > 0; Level -= BitsPerLevel){
+        Node = Node->Children[(Index >> Level) & SlotMask].get();
+    }
+
+    return &Node->Elements[Index & SlotMask];
+}
+
+JsonPersistentValue JsonPersistentValue::SetElement(const std::size_t Index, const JsonPersistentValue& Value) const
+{
+    JsonPersistentValue Version = *this;
+
+    if(Type == EJson::Array && Index < Size){
+        AssignElement(Version.Root, Shift, Index, Value);
+    }
+
+    return Version;
+}
+
+JsonPersistentValue JsonPersistentValue::PushBack(const JsonPersistentValue& Value) const
+{
+    JsonPersistentValue Version = *this;
+
+    if(Type != EJson::Array){
+        return Version;
+    }
+
+    if(!Root){
+        Version.Root = NewPath(0, Value);
+    }else if(Size == (std::size_t{1} << (Shift + BitsPerLevel))){
+        // The trie is full: grow a level on top
+        std::shared_ptr<JsonPersistentNode> NewRoot = std::make_shared<JsonPersistentNode>();
+
+        NewRoot->Children.push_back(Root);
+        NewRoot->Children.push_back(NewPath(Shift, Value));
+        Version.Root = std::move(NewRoot);
+        Version.Shift += BitsPerLevel;
+    }else{
+        AppendElement(Version.Root, Shift, Size, Value);
+    }
+
+    ++Version.Size;
+    return Version;
+}
+
+JsonPersistentValue JsonPersistentValue::PopBack() const
+{
+    JsonPersistentValue Version = *this;
+
+    if(Type != EJson::Array || Size == 0){
+        return Version;
+    }
+
+    RemoveLastElement(Version.Root, Shift, Size - 1);
+    --Version.Size;
+
+    // Drop top levels that are left with a single child
+    while(Version.Root && Version.Shift > 0 && Version.Root->Children.size() == 1){
+        Version.Root = NodePtr(Version.Root->Children.front());
+        Version.Shift -= BitsPerLevel;
+    }
+
+    if(!Version.Root){
+        Version.Shift = 0;
+    }
+
+    return Version;
+}
+
+JsonPersistentValue JsonPersistentValue::RemoveElement(const std::size_t Index) const
+{
+    if(Type != EJson::Array || Index >= Size){
+        return *this;
+    }
+
+    if(Index + 1 == Size){
+        return PopBack();
+    }
+
+    std::vector<JsonPersistentValue> Elements;
+    Elements.reserve(Size - 1);
+
+    for(std::size_t i = 0; i < Size; ++i){
+        if(i != Index){
+            Elements.push_back(*GetElement(i));
+        }
+    }
+
+    JsonPersistentValue Version = MakeArray();
+    Version.Size = Elements.size();
+    Version.Root = BuildArray(std::move(Elements), Version.Shift);
+    return Version;
+}
+
+const JsonPersistentValue* JsonPersistentValue::Find(const JsonPointer& Path) const
+{
+    if(!Path.IsValid()){
+        return nullptr;
+    }
+
+    const JsonPersistentValue* Value = this;
+
+    for(std::size_t Position = 0; Value && Position < Path.GetSegmentCount(); ++Position){
+        const JsonPointer::Segment& Segment = Path.GetSegment(Position);
+
+        if(Segment.bWildcard){
+            return nullptr;
+        }
+
+        Value = Value->Type == EJson::Object ? Value->TryGetField(Segment.GetKey()) : Value->GetElement(Segment.Index);
+    }
+
+    return Value;
+}
+
+bool JsonPersistentValue::TrySetAt(const JsonPointer& Path, const JsonPersistentValue& Value, JsonPersistentValue& OutVersion) const
+{
+    if(!Path.IsValid() || Path.HasWildcards()){
+        return false;
+    }
+
+    if(Path.GetSegmentCount() == 0){
+        OutVersion = Value;
+        return true;
+    }
+
+    return SetAt(Path, 0, Value, OutVersion);
+}
+
+bool JsonPersistentValue::TryRemoveAt(const JsonPointer& Path, JsonPersistentValue& OutVersion) const
+{
+    if(!Path.IsValid() || Path.HasWildcards() || Path.GetSegmentCount() == 0){
+        return false;
+    }
+
+    return RemoveAt(Path, 0, OutVersion);
+}
+
+bool JsonPersistentValue::SetAt(const JsonPointer& Path, const std::size_t Position, const JsonPersistentValue& Value, JsonPersistentValue& OutVersion) const
+{
+    const JsonPointer::Segment& Segment = Path.GetSegment(Position);
+    const bool bLast = Position + 1 == Path.GetSegmentCount();
+
+    if(Type == EJson::Object){
+        if(bLast){
+            OutVersion = SetField(Segment.GetKey(), Value);
+            return true;
+        }
+
+        const JsonPersistentValue* Child = TryGetField(Segment.GetKey());
+        JsonPersistentValue NewChild;
+
+        if(!Child || !Child->SetAt(Path, Position + 1, Value, NewChild)){
+            return false;
+        }
+
+        OutVersion = SetField(Segment.GetKey(), NewChild);
+        return true;
+    }
+
+    if(Type == EJson::Array){
+        if(bLast && (Segment.Index == Size || Segment.Name == "-")){
+            OutVersion = PushBack(Value);
+            return true;
+        }
+
+        const JsonPersistentValue* Child = GetElement(Segment.Index);
+
+        if(!Child){
+            return false;
+        }
+
+        if(bLast){
+            OutVersion = SetElement(Segment.Index, Value);
+            return true;
+        }
+
+        JsonPersistentValue NewChild;
+
+        if(!Child->SetAt(Path, Position + 1, Value, NewChild)){
+            return false;
+        }
+
+        OutVersion = SetElement(Segment.Index, NewChild);
+        return true;
+    }
+
+    return false;
+}
+
+bool JsonPersistentValue::RemoveAt(const JsonPointer& Path, const std::size_t Position, JsonPersistentValue& OutVersion) const
+{
+    const JsonPointer::Segment& Segment = Path.GetSegment(Position);
+    const bool bLast = Position + 1 == Path.GetSegmentCount();
+    const JsonPersistentValue* Child = Type == EJson::Object ? TryGetField(Segment.GetKey()) : GetElement(Segment.Index);
+
+    if(!Child){
+        return false;
+    }
+
+    if(bLast){
+        OutVersion = Type == EJson::Object ? RemoveField(Segment.GetKey()) : RemoveElement(Segment.Index);
+        return true;
+    }
+
+    JsonPersistentValue NewChild;
+
+    if(!Child->RemoveAt(Path, Position + 1, NewChild)){
+        return false;
+    }
+
+    OutVersion = Type == EJson::Object ? SetField(Segment.GetKey(), NewChild) : SetElement(Segment.Index, NewChild);
+    return true;
+}
+
+std::shared_ptr<JsonValue> JsonPersistentValue::ToValue() const
+{
+    switch (Type)
+    {
+    case EJson::Object:
+    {
+        std::shared_ptr<JsonObject> Object = std::make_shared<JsonObject>();
+        FieldList Fields;
+        GetFields(Fields);
+
+        for(const auto& [Name, Value] : Fields){
+            Object->SetField(Name, Value->ToValue());
+        }
+
+        return std::make_shared<JsonValueObject>(std::move(Object));
+    }
+
+    case EJson::Array:
+    {
+        JsonArray Elements;
+        Elements.reserve(Size);
+
+        for(std::size_t i = 0; i < Size; ++i){
+            Elements.push_back(GetElement(i)->ToValue());
+        }
+
+        return std::make_shared<JsonValueArray>(std::move(Elements));
+    }
+
+    case EJson::Null:
+        return std::make_shared<JsonValueNull>();
+
+    default:
+        // Scalars never change once shared, see the class comment
+        return std::const_pointer_cast<JsonValue>(Scalar);
+    }
+}
@@ -0,0 +1,187 @@
+#include "Domain/JsonPointer.hpp"
+
+using namespace zexjson;
+
+namespace{
+
+/** Returns the index a segment stands for: "0" or digits without a leading zero */
+std::size_t ParseIndex(const std::string_view Name)
+{
+    if(Name.empty() || (Name[0] == '0' && Name.size() > 1)){
+        return JsonPointer::NoIndex;
+    }
+
+    std::size_t Index;
+    const std::from_chars_result Result = std::from_chars(Name.data(), Name.data() + Name.size(), Index);
+
+    if(Result.ec != std::errc() || Result.ptr != Name.data() + Name.size() || Index == JsonPointer::NoIndex){
+        return JsonPointer::NoIndex;
+    }
+
+    return Index;
+}
+
+/**
+ * Calls OnMatch with every value below Value matching the segments from Depth
+ * on. Stops and returns false as soon as OnMatch does.
+*/
+template<class CallbackType>
+bool FindFrom(const JsonPointer& Pointer, const std::size_t Depth, const JsonValue& Value, CallbackType& OnMatch);
+
+template<class CallbackType>
+bool FindInObject(const JsonPointer& Pointer, const std::size_t Depth, const JsonObject& Object, CallbackType& OnMatch)
+{
+    const JsonPointer::Segment& Segment = Pointer.GetSegment(Depth);
+
+    if(!Segment.bWildcard){
+        const auto FieldIt = Object.Values.find(Segment.GetKey());
+        return FieldIt == Object.Values.end() || !FieldIt->second || FindFrom(Pointer, Depth + 1, *FieldIt->second, OnMatch);
+    }
+
+    for(const auto& [Name, Field] : Object.Values){
+        if(Field && !FindFrom(Pointer, Depth + 1, *Field, OnMatch)){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template<class CallbackType>
+bool FindFrom(const JsonPointer& Pointer, const std::size_t Depth, const JsonValue& Value, CallbackType& OnMatch)
+{
+    if(Depth == Pointer.GetSegmentCount()){
+        return OnMatch(Value);
+    }
+
+    const std::shared_ptr<JsonObject>* Object;
+
+    if(Value.TryGetObject(Object)){
+        return !*Object || FindInObject(Pointer, Depth, **Object, OnMatch);
+    }
+
+    const JsonArray* Array;
+
+    if(!Value.TryGetArray(Array)){
+        return true;
+    }
+
+    const JsonPointer::Segment& Segment = Pointer.GetSegment(Depth);
+
+    if(!Segment.bWildcard){
+        return Segment.Index >= Array->size() || !(*Array)[Segment.Index] || FindFrom(Pointer, Depth + 1, *(*Array)[Segment.Index], OnMatch);
+    }
+
+    for(const std::shared_ptr<JsonValue>& Element : *Array){
+        if(Element && !FindFrom(Pointer, Depth + 1, *Element, OnMatch)){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+JsonPointer::JsonPointer(std::string_view Text, bool bAllowWildcards) :
+    bValid(true)
+{
+    if(Text.empty()){
+        return;
+    }
+
+    if(Text[0] != '/'){
+        bValid = false;
+        ErrorMessage = "Json Pointer must be empty or start with '/'.";
+        return;
+    }
+
+    std::size_t Start = 1;
+
+    while(true){
+        const std::size_t End = std::min(Text.find('/', Start), Text.size());
+        const std::string_view Token = Text.substr(Start, End - Start);
+
+        Segment& NewSegment = Segments.emplace_back();
+        NewSegment.Name.reserve(Token.size());
+
+        for(std::size_t i{0}; i < Token.size(); ++i){
+            if(Token[i] != '~'){
+                NewSegment.Name += Token[i];
+                continue;
+            }
+
+            if(i + 1 < Token.size() && (Token[i + 1] == '0' || Token[i + 1] == '1')){
+                NewSegment.Name += Token[++i] == '0' ? '~' : '/';
+                continue;
+            }
+
+            Segments.clear();
+            bValid = false;
+            ErrorMessage = "Invalid escape in Json Pointer, '~' must be followed by '0' or '1'.";
+            return;
+        }
+
+        NewSegment.Hash = JsonKey::HashName(NewSegment.Name);
+        NewSegment.Index = ParseIndex(NewSegment.Name);
+        NewSegment.bWildcard = bAllowWildcards && Token == "*";
+
+        if(End == Text.size()){
+            break;
+        }
+
+        Start = End + 1;
+    }
+}
+
+bool JsonPointer::HasWildcards() const
+{
+    return std::any_of(Segments.begin(), Segments.end(), [](const Segment& Each){ return Each.bWildcard; });
+}
+
+const JsonValue* JsonPointer::Find(const JsonValue& Root) const
+{
+    const JsonValue* Match = nullptr;
+
+    auto OnMatch = [&Match](const JsonValue& Value)
+    {
+        Match = &Value;
+        return false;
+    };
+
+    if(bValid){
+        FindFrom(*this, 0, Root, OnMatch);
+    }
+
+    return Match;
+}
+
+const JsonValue* JsonPointer::Find(const JsonObject& Root) const
+{
+    const JsonValue* Match = nullptr;
+
+    auto OnMatch = [&Match](const JsonValue& Value)
+    {
+        Match = &Value;
+        return false;
+    };
+
+    if(bValid && !Segments.empty()){
+        FindInObject(*this, 0, Root, OnMatch);
+    }
+
+    return Match;
+}
+
+void JsonPointer::FindAll(const JsonValue& Root, std::vector<const JsonValue*>& OutMatches) const
+{
+    auto OnMatch = [&OutMatches](const JsonValue& Value)
+    {
+        OutMatches.push_back(&Value);
+        return true;
+    };
+
+    if(bValid){
+        FindFrom(*this, 0, Root, OnMatch);
+    }
+}
@@ -0,0 +1,427 @@
+#include "Domain/JsonProjection.hpp"
+
+#include <map>
+
+using namespace zexjson;
+
+namespace{
+
+/** A node of the trie the pointers are merged into before building the automaton */
+struct TrieNode
+{
+    /** Children by member name, with the array index each name stands for */
+    std::map<std::string, std::pair<std::uint32_t, std::size_t>> Named;
+
+    std::uint32_t Wildcard = JsonProjection::NoState;
+
+    std::vector<std::uint32_t> Paths;
+};
+
+/** Sorts a set of indices and removes duplicates */
+void Normalize(std::vector<std::uint32_t>& Set)
+{
+    std::sort(Set.begin(), Set.end());
+    Set.erase(std::unique(Set.begin(), Set.end()), Set.end());
+}
+
+} // namespace
+
+JsonProjection::JsonProjection(const std::vector<std::string_view>& Paths, bool bAllowWildcards) :
+    bValid(true)
+{
+    Pointers.reserve(Paths.size());
+
+    for(const std::string_view Path : Paths){
+        Pointers.emplace_back(Path, bAllowWildcards);
+    }
+
+    Compile();
+}
+
+JsonProjection::JsonProjection(std::vector<JsonPointer> InPointers) :
+    Pointers(std::move(InPointers)), bValid(true)
+{
+    Compile();
+}
+
+void JsonProjection::Compile()
+{
+    for(std::size_t Path{0}; Path < Pointers.size(); ++Path){
+        if(!Pointers[Path].IsValid()){
+            bValid = false;
+            ErrorMessage = "Path " + std::to_string(Path) + " is invalid: " + Pointers[Path].GetErrorMessage();
+            return;
+        }
+    }
+
+    std::vector<TrieNode> Trie(1);
+
+    for(std::size_t Path{0}; Path < Pointers.size(); ++Path){
+        std::uint32_t Node = 0;
+
+        for(std::size_t Depth{0}; Depth < Pointers[Path].GetSegmentCount(); ++Depth){
+            const JsonPointer::Segment& Segment = Pointers[Path].GetSegment(Depth);
+            const std::uint32_t NewNode = static_cast<std::uint32_t>(Trie.size());
+
+            if(Segment.bWildcard){
+                if(Trie[Node].Wildcard == NoState){
+                    Trie[Node].Wildcard = NewNode;
+                    Trie.emplace_back();
+                }
+
+                Node = Trie[Node].Wildcard;
+            }else{
+                const auto [ChildIt, bAdded] = Trie[Node].Named.try_emplace(Segment.Name, NewNode, Segment.Index);
+
+                if(bAdded){
+                    Trie.emplace_back();
+                }
+
+                Node = ChildIt->second.first;
+            }
+        }
+
+        Trie[Node].Paths.push_back(static_cast<std::uint32_t>(Path));
+    }
+
+    // Subset construction: each state is a set of trie nodes a value can be at.
+    // Children always sit one level deeper, so every transition leads to a
+    // state created after its source.
+    std::map<std::vector<std::uint32_t>, StateIndex> Known;
+    std::vector<std::vector<std::uint32_t>> Sets;
+
+    auto AddState = [this, &Known, &Sets](std::vector<std::uint32_t>&& Set)
+    {
+        Normalize(Set);
+
+        const auto [KnownIt, bAdded] = Known.try_emplace(Set, static_cast<StateIndex>(States.size()));
+
+        if(bAdded){
+            States.emplace_back();
+            Sets.push_back(std::move(Set));
+        }
+
+        return KnownIt->second;
+    };
+
+    AddState({0});
+
+    for(StateIndex Index{0}; Index < States.size(); ++Index){
+        const std::vector<std::uint32_t> Set = Sets[Index];
+
+        std::vector<std::uint32_t> Paths;
+        std::vector<std::uint32_t> Wildcards;
+        std::map<std::string_view, std::pair<std::vector<std::uint32_t>, std::size_t>> ByName;
+
+        for(const std::uint32_t Node : Set){
+            Paths.insert(Paths.end(), Trie[Node].Paths.begin(), Trie[Node].Paths.end());
+
+            if(Trie[Node].Wildcard != NoState){
+                Wildcards.push_back(Trie[Node].Wildcard);
+            }
+
+            for(const auto& [Name, Child] : Trie[Node].Named){
+                auto& Entry = ByName[Name];
+                Entry.first.push_back(Child.first);
+                Entry.second = Child.second;
+            }
+        }
+
+        // A named member also moves every wildcard along
+        const StateIndex Other = Wildcards.empty() ? NoState : AddState(std::vector<std::uint32_t>(Wildcards));
+        std::vector<State::NameTransition> Names;
+        std::vector<std::pair<std::size_t, StateIndex>> Indices;
+
+        for(auto& [Name, Entry] : ByName){
+            Entry.first.insert(Entry.first.end(), Wildcards.begin(), Wildcards.end());
+
+            const StateIndex Target = AddState(std::move(Entry.first));
+            Names.push_back({std::string(Name), JsonKey::HashName(Name), Target});
+
+            if(Entry.second != JsonPointer::NoIndex){
+                Indices.emplace_back(Entry.second, Target);
+            }
+        }
+
+        std::sort(Indices.begin(), Indices.end());
+        Normalize(Paths);
+
+        State& Current = States[Index];
+        Current.Paths = std::move(Paths);
+        Current.Names = std::move(Names);
+        Current.Indices = std::move(Indices);
+        Current.Other = Other;
+
+        if(Current.Names.size() > NameTableThreshold){
+            std::size_t TableSize = 16;
+
+            while(TableSize < Current.Names.size() * 2){
+                TableSize *= 2;
+            }
+
+            Current.NameTable.assign(TableSize, 0);
+
+            for(std::size_t Position{0}; Position < Current.Names.size(); ++Position){
+                std::size_t Slot = Current.Names[Position].Hash & (TableSize - 1);
+
+                while(Current.NameTable[Slot] != 0){
+                    Slot = (Slot + 1) & (TableSize - 1);
+                }
+
+                Current.NameTable[Slot] = static_cast<std::uint32_t>(Position + 1);
+            }
+        }
+    }
+
+    // Collect the paths ending in each state or below it, deepest states first
+    std::vector<std::vector<std::uint32_t>> Reachable(States.size());
+    PendingStates.assign(Pointers.size(), {});
+
+    for(StateIndex Index = static_cast<StateIndex>(States.size()); Index-- > 0;){
+        State& Current = States[Index];
+        std::vector<std::uint32_t>& Below = Reachable[Index];
+        Below = Current.Paths;
+
+        auto AddFrom = [&Below, &Reachable](const StateIndex Target)
+        {
+            if(Target != NoState){
+                Below.insert(Below.end(), Reachable[Target].begin(), Reachable[Target].end());
+            }
+        };
+
+        for(const State::NameTransition& Transition : Current.Names){
+            AddFrom(Transition.Target);
+        }
+
+        AddFrom(Current.Other);
+        Normalize(Below);
+
+        for(const std::uint32_t Path : Below){
+            if(Pointers[Path].HasWildcards()){
+                Current.bUnbounded = true;
+            }else{
+                ++Current.PendingPaths;
+                PendingStates[Path].push_back(Index);
+            }
+        }
+    }
+}
+
+JsonProjection::StateIndex JsonProjection::FindMember(const StateIndex From, const std::string_view Name) const
+{
+    const State& Current = States[From];
+
+    if(Current.NameTable.empty()){
+        for(const State::NameTransition& Transition : Current.Names){
+            if(Transition.Name == Name){
+                return Transition.Target;
+            }
+        }
+
+        return Current.Other;
+    }
+
+    const std::size_t Mask = Current.NameTable.size() - 1;
+
+    for(std::size_t Slot = JsonKey::HashName(Name) & Mask; Current.NameTable[Slot] != 0; Slot = (Slot + 1) & Mask){
+        const State::NameTransition& Transition = Current.Names[Current.NameTable[Slot] - 1];
+
+        if(Transition.Name == Name){
+            return Transition.Target;
+        }
+    }
+
+    return Current.Other;
+}
+
+JsonProjection::StateIndex JsonProjection::FindElement(const StateIndex From, const std::size_t Index) const
+{
+    const State& Current = States[From];
+
+    const auto IndexIt = std::lower_bound(Current.Indices.begin(), Current.Indices.end(), Index,
+        [](const std::pair<std::size_t, StateIndex>& Transition, const std::size_t Value){ return Transition.first < Value; });
+
+    return IndexIt != Current.Indices.end() && IndexIt->first == Index ? IndexIt->second : Current.Other;
+}
+
+void JsonProjection::Project(const std::shared_ptr<JsonValue>& Root, JsonProjectionResult& OutResult) const
+{
+    OutResult.Reset(*this);
+
+    if(bValid && Root){
+        ProjectFrom(RootState, Root, OutResult);
+    }
+}
+
+void JsonProjection::ProjectFrom(const StateIndex Index, const std::shared_ptr<JsonValue>& Value, JsonProjectionResult& OutResult) const
+{
+    if(OutResult.IsDone(Index)){
+        return;
+    }
+
+    const State& Current = States[Index];
+
+    if(!Current.Paths.empty()){
+        OutResult.Capture(Index, Value);
+    }
+
+    if(!Current.HasTransitions()){
+        return;
+    }
+
+    const std::shared_ptr<JsonObject>* Object;
+
+    if(Value->TryGetObject(Object)){
+        if(*Object){
+            ProjectObject(Index, **Object, OutResult);
+        }
+
+        return;
+    }
+
+    const JsonArray* Array;
+
+    if(Value->TryGetArray(Array)){
+        ProjectArray(Index, *Array, OutResult);
+    }
+}
+
+void JsonProjection::ProjectObject(const StateIndex Index, const JsonObject& Object, JsonProjectionResult& OutResult) const
+{
+    const State& Current = States[Index];
+
+    if(Current.Other == NoState){
+        // Only the listed names can match, so look them up rather than walking every field
+        for(const State::NameTransition& Transition : Current.Names){
+            const auto FieldIt = Object.Values.find(JsonKey(Transition.Name, Transition.Hash));
+
+            if(FieldIt != Object.Values.end() && FieldIt->second){
+                ProjectFrom(Transition.Target, FieldIt->second, OutResult);
+
+                if(OutResult.IsDone(Index)){
+                    return;
+                }
+            }
+        }
+
+        return;
+    }
+
+    for(const auto& [Name, Field] : Object.Values){
+        const StateIndex Target = FindMember(Index, Name.View());
+
+        if(Field && Target != NoState){
+            ProjectFrom(Target, Field, OutResult);
+
+            if(OutResult.IsDone(Index)){
+                return;
+            }
+        }
+    }
+}
+
+void JsonProjection::ProjectArray(const StateIndex Index, const JsonArray& Array, JsonProjectionResult& OutResult) const
+{
+    const State& Current = States[Index];
+
+    if(Current.Other == NoState){
+        for(const auto& [ElementIndex, Target] : Current.Indices){
+            if(ElementIndex >= Array.size()){
+                break;
+            }
+
+            if(Array[ElementIndex]){
+                ProjectFrom(Target, Array[ElementIndex], OutResult);
+
+                if(OutResult.IsDone(Index)){
+                    return;
+                }
+            }
+        }
+
+        return;
+    }
+
+    for(std::size_t ElementIndex{0}; ElementIndex < Array.size(); ++ElementIndex){
+        const StateIndex Target = FindElement(Index, ElementIndex);
+
+        if(Array[ElementIndex] && Target != NoState){
+            ProjectFrom(Target, Array[ElementIndex], OutResult);
+
+            if(OutResult.IsDone(Index)){
+                return;
+            }
+        }
+    }
+}
+
+void JsonProjectionResult::Reset(const JsonProjection& InProjection)
+{
+    Projection = &InProjection;
+    Matches.clear();
+
+    First.assign(InProjection.GetPathCount(), NoMatch);
+    Last.assign(InProjection.GetPathCount(), NoMatch);
+    Counts.assign(InProjection.GetPathCount(), 0);
+
+    Remaining.resize(InProjection.GetStateCount());
+
+    for(JsonProjection::StateIndex Index{0}; Index < InProjection.GetStateCount(); ++Index){
+        Remaining[Index] = InProjection.GetState(Index).PendingPaths;
+    }
+}
+
+const std::shared_ptr<JsonValue>& JsonProjectionResult::Get(const std::size_t Path) const
+{
+    static const std::shared_ptr<JsonValue> NoValue;
+
+    return First[Path] != NoMatch ? Matches[First[Path]].Value : NoValue;
+}
+
+void JsonProjectionResult::GetAll(const std::size_t Path, std::vector<std::shared_ptr<JsonValue>>& OutMatches) const
+{
+    for(std::uint32_t Position = First[Path]; Position != NoMatch; Position = Matches[Position].Next){
+        OutMatches.push_back(Matches[Position].Value);
+    }
+}
+
+bool JsonProjectionResult::Wants(const JsonProjection::StateIndex Index) const
+{
+    for(const std::uint32_t Path : Projection->GetState(Index).Paths){
+        if(First[Path] == NoMatch || Projection->GetPendingStates(Path).empty()){
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void JsonProjectionResult::Capture(const JsonProjection::StateIndex Index, const std::shared_ptr<JsonValue>& Value)
+{
+    for(const std::uint32_t Path : Projection->GetState(Index).Paths){
+        // Paths without wildcards are pending somewhere, at least in the root, and take only their first match
+        const std::vector<JsonProjection::StateIndex>& Pending = Projection->GetPendingStates(Path);
+
+        if(!Pending.empty()){
+            if(First[Path] != NoMatch){
+                continue;
+            }
+
+            for(const JsonProjection::StateIndex PendingIndex : Pending){
+                --Remaining[PendingIndex];
+            }
+        }
+
+        const std::uint32_t Position = static_cast<std::uint32_t>(Matches.size());
+        Matches.push_back({Value, NoMatch});
+
+        if(First[Path] == NoMatch){
+            First[Path] = Position;
+        }else{
+            Matches[Last[Path]].Next = Position;
+        }
+
+        Last[Path] = Position;
+        ++Counts[Path];
+    }
+}
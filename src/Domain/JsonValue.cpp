@@ -1,10 +1,18 @@
 #include "Domain/JsonValue.hpp"
+#include "Domain/JsonObject.hpp"
+#include "Serialization/JsonUtils.hpp"
 
 #include <limits>
 #include <cmath>
 
 using namespace zexjson;
 
+JsonValue::JsonValue() :
+    Type(EJson::None)
+{}
+
+JsonValue::~JsonValue() = default;
+
 bool JsonValue::IsNull() const
 {
     return Type == EJson::Null || Type == EJson::None;
@@ -25,7 +33,7 @@ void JsonValue::AsArgumentType(bool& Value)
     Value = AsBool();
 }
 
-void JsonValue::AsArgumentType(std::vector<std::shared_ptr<JsonValue>>& Value)
+void JsonValue::AsArgumentType(JsonArray& Value)
 {
     Value = AsArray();
 }
@@ -35,16 +43,6 @@ void JsonValue::AsArgumentType(std::shared_ptr<JsonObject>& Value)
     Value = AsObject();
 }
 
-inline bool operator==(const JsonValue& Lhs, const JsonValue& Rhs)
-{
-    return JsonValue::CompareEqual(Lhs, Rhs);
-}
-
-inline bool operator!=(const JsonValue& Lhs, const JsonValue& Rhs)
-{
-    return !JsonValue::CompareEqual(Lhs, Rhs);
-}
-
 double JsonValue::AsNumber() const
 {
     double Number{0.0};
@@ -78,12 +76,12 @@ bool JsonValue::AsBool() const
     return Bool;
 }
 
-const std::vector<std::shared_ptr<JsonValue>>& JsonValue::AsArray() const
+const JsonArray& JsonValue::AsArray() const
 {
-    const std::vector<std::shared_ptr<JsonValue>>* Array{nullptr};
+    const JsonArray* Array{nullptr};
 
     if(!TryGetArray(Array)){
-        static const std::vector<std::shared_ptr<JsonValue>> EmptyArray;
+        static const JsonArray EmptyArray;
         Array = &EmptyArray;
         // TODO: Error message here
     }
@@ -144,7 +142,7 @@ bool TryConvertNumber<std::int64_t>(const JsonValue& InValue, std::int64_t& OutN
     double Double;
     const double _2_to_63 = 9223372036854775808.0;
 
-    if(InValue.TryGetNumber(Double) && Double >= -_2_to_63 && Double <= _2_to_63){
+    if(InValue.TryGetNumber(Double) && Double >= -_2_to_63 && Double < _2_to_63){
         OutNumber = static_cast<std::int64_t>(std::round(Double));
 
         return true;
@@ -209,6 +207,318 @@ bool JsonValue::TryGetNumber(std::uint64_t& OutNumber) const
 }
 
 
+// =====================
+
+JsonValueNumber::JsonValueNumber(double InNumber) :
+    Value(InNumber), NumberType(EJsonNumber::Double)
+{
+    Type = EJson::Number;
+}
+
+JsonValueNumber::JsonValueNumber(std::int64_t InNumber) :
+    Int64Value(InNumber), NumberType(EJsonNumber::Int64)
+{
+    Type = EJson::Number;
+}
+
+JsonValueNumber::JsonValueNumber(std::uint64_t InNumber) :
+    UInt64Value(InNumber), NumberType(EJsonNumber::UInt64)
+{
+    Type = EJson::Number;
+
+    // Keep a single representation for every integer that fits in int64
+    if(InNumber <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max())){
+        NumberType = EJsonNumber::Int64;
+    }
+}
+
+template<typename T>
+bool JsonValueNumber::TryGetInteger(T& OutNumber) const
+{
+    switch (NumberType)
+    {
+    case EJsonNumber::Int64:
+        if constexpr (std::is_signed_v<T>){
+            if(Int64Value < std::numeric_limits<T>::min() || Int64Value > std::numeric_limits<T>::max()){
+                return false;
+            }
+        }else{
+            if(Int64Value < 0 || static_cast<std::uint64_t>(Int64Value) > std::numeric_limits<T>::max()){
+                return false;
+            }
+        }
+
+        OutNumber = static_cast<T>(Int64Value);
+        return true;
+
+    case EJsonNumber::UInt64:
+        if(UInt64Value > static_cast<std::uint64_t>(std::numeric_limits<T>::max())){
+            return false;
+        }
+
+        OutNumber = static_cast<T>(UInt64Value);
+        return true;
+
+    default:
+        return TryConvertNumber(*this, OutNumber);
+    }
+}
+
+bool JsonValueNumber::TryGetNumber(double& OutNumber) const
+{
+    switch (NumberType)
+    {
+    case EJsonNumber::Int64:
+        OutNumber = static_cast<double>(Int64Value);
+        break;
+
+    case EJsonNumber::UInt64:
+        OutNumber = static_cast<double>(UInt64Value);
+        break;
+
+    default:
+        OutNumber = Value;
+        break;
+    }
+
+    return true;
+}
+
+bool JsonValueNumber::TryGetNumber(std::int8_t& OutNumber) const
+{
+    return TryGetInteger(OutNumber);
+}
+
+bool JsonValueNumber::TryGetNumber(std::int16_t& OutNumber) const
+{
+    return TryGetInteger(OutNumber);
+}
+
+bool JsonValueNumber::TryGetNumber(std::int32_t& OutNumber) const
+{
+    return TryGetInteger(OutNumber);
+}
+
+bool JsonValueNumber::TryGetNumber(std::int64_t& OutNumber) const
+{
+    return TryGetInteger(OutNumber);
+}
+
+bool JsonValueNumber::TryGetNumber(std::uint8_t& OutNumber) const
+{
+    return TryGetInteger(OutNumber);
+}
+
+bool JsonValueNumber::TryGetNumber(std::uint16_t& OutNumber) const
+{
+    return TryGetInteger(OutNumber);
+}
+
+bool JsonValueNumber::TryGetNumber(std::uint32_t& OutNumber) const
+{
+    return TryGetInteger(OutNumber);
+}
+
+bool JsonValueNumber::TryGetNumber(std::uint64_t& OutNumber) const
+{
+    return TryGetInteger(OutNumber);
+}
+
+bool JsonValueNumber::TryGetBool(bool& OutBool) const
+{
+    double Double;
+    TryGetNumber(Double);
+    OutBool = Double != 0.0;
+
+    return true;
+}
+
+bool JsonValueNumber::TryGetString(std::string& OutString) const
+{
+    char Buffer[32];
+    std::to_chars_result Result;
+
+    switch (NumberType)
+    {
+    case EJsonNumber::Int64:
+        Result = std::to_chars(Buffer, Buffer + sizeof(Buffer), Int64Value);
+        break;
+
+    case EJsonNumber::UInt64:
+        Result = std::to_chars(Buffer, Buffer + sizeof(Buffer), UInt64Value);
+        break;
+
+    default:
+        Result = std::to_chars(Buffer, Buffer + sizeof(Buffer), Value);
+        break;
+    }
+
+    OutString.assign(Buffer, Result.ptr);
+
+    return true;
+}
+
+bool JsonValueNumber::Equals(const JsonValueNumber& Other) const
+{
+    if(NumberType != EJsonNumber::Double && Other.NumberType != EJsonNumber::Double){
+        // Int64 and UInt64 ranges don't overlap, see the UInt64 constructor
+        return NumberType == Other.NumberType && Int64Value == Other.Int64Value;
+    }
+
+    double Lhs, Rhs;
+    TryGetNumber(Lhs);
+    Other.TryGetNumber(Rhs);
+
+    return Lhs == Rhs;
+}
+
+// =====================
+
+/** Parses the whole string as an integer, without going through double */
+template<typename T>
+bool TryParseInteger(const std::string_view String, T& OutNumber)
+{
+    const char* const End = String.data() + String.size();
+    const std::from_chars_result Result = std::from_chars(String.data(), End, OutNumber);
+
+    return Result.ec == std::errc() && Result.ptr == End;
+}
+
+JsonValueString::JsonValueString(const std::string_view InString, std::pmr::memory_resource* Resource) :
+    Value(InString, Resource)
+{
+    Type = EJson::String;
+}
+
+JsonValueString::JsonValueString(const char* InString) :
+    Value(InString)
+{
+    Type = EJson::String;
+}
+
+bool JsonValueString::TryGetString(std::string& OutString) const
+{
+    OutString.assign(Value.data(), Value.size());
+    return true;
+}
+
+bool JsonValueString::TryGetNumber(double& OutNumber) const
+{
+    const char* const End = Value.data() + Value.size();
+    const std::from_chars_result Result = std::from_chars(Value.data(), End, OutNumber);
+
+    return !Value.empty() && Result.ec == std::errc() && Result.ptr == End;
+}
+
+bool JsonValueString::TryGetNumber(std::int32_t& OutNumber) const
+{
+    return TryParseInteger(Value, OutNumber) || JsonValue::TryGetNumber(OutNumber);
+}
+
+bool JsonValueString::TryGetNumber(std::uint32_t& OutNumber) const
+{
+    return TryParseInteger(Value, OutNumber) || JsonValue::TryGetNumber(OutNumber);
+}
+
+bool JsonValueString::TryGetNumber(std::int64_t& OutNumber) const
+{
+    return TryParseInteger(Value, OutNumber) || JsonValue::TryGetNumber(OutNumber);
+}
+
+bool JsonValueString::TryGetNumber(std::uint64_t& OutNumber) const
+{
+    return TryParseInteger(Value, OutNumber) || JsonValue::TryGetNumber(OutNumber);
+}
+
+bool JsonValueString::TryGetBool(bool& OutBool) const
+{
+    double Number;
+
+    if(TryGetNumber(Number)){
+        OutBool = Number != 0.0;
+    }else{
+        OutBool = JsonUtils::EqualsIgnoreCase(Value, "true") ||
+            JsonUtils::EqualsIgnoreCase(Value, "yes") ||
+            JsonUtils::EqualsIgnoreCase(Value, "on");
+    }
+
+    return true;
+}
+
+bool JsonValueString::IsEmpty() const
+{
+    return Value.empty();
+}
+
+// =====================
+
+JsonValueBoolean::JsonValueBoolean(bool InBool) :
+    Value(InBool)
+{
+    Type = EJson::Boolean;
+}
+
+bool JsonValueBoolean::TryGetNumber(double& OutNumber) const
+{
+    OutNumber = Value ? 1.0 : 0.0;
+    return true;
+}
+
+bool JsonValueBoolean::TryGetBool(bool& OutBool) const
+{
+    OutBool = Value;
+    return true;
+}
+
+bool JsonValueBoolean::TryGetString(std::string& OutString) const
+{
+    OutString = Value ? "true" : "false";
+    return true;
+}
+
+// =====================
+
+JsonValueArray::JsonValueArray(const JsonArray& InArray) :
+    Value(InArray)
+{
+    Type = EJson::Array;
+}
+
+JsonValueArray::JsonValueArray(JsonArray&& InArray) :
+    Value(std::move(InArray))
+{
+    Type = EJson::Array;
+}
+
+bool JsonValueArray::TryGetArray(const JsonArray*& OutArray) const
+{
+    OutArray = &Value;
+    return true;
+}
+
+// =====================
+
+JsonValueObject::JsonValueObject(std::shared_ptr<JsonObject> InObject) :
+    Value(std::move(InObject))
+{
+    Type = EJson::Object;
+}
+
+bool JsonValueObject::TryGetObject(const std::shared_ptr<JsonObject>*& OutObject) const
+{
+    OutObject = &Value;
+    return true;
+}
+
+// =====================
+
+JsonValueNull::JsonValueNull()
+{
+    Type = EJson::Null;
+}
+
+// =====================
+
 // static
 bool JsonValue::CompareEqual(const JsonValue& Lhs, const JsonValue& Rhs)
 {
@@ -226,7 +536,7 @@ bool JsonValue::CompareEqual(const JsonValue& Lhs, const JsonValue& Rhs)
         return Lhs.AsString() == Rhs.AsString();
 
     case EJson::Number:
-        return Lhs.AsNumber() == Rhs.AsNumber();
+        return static_cast<const JsonValueNumber&>(Lhs).Equals(static_cast<const JsonValueNumber&>(Rhs));
 
     case EJson::Boolean:
         return Lhs.AsBool() == Rhs.AsBool();
@@ -259,10 +569,28 @@ bool JsonValue::CompareEqual(const JsonValue& Lhs, const JsonValue& Rhs)
         }
 
         if(LhsObject){
-            // if(LhsObject->Values)
+            if(LhsObject->Values.size() != RhsObject->Values.size()){
+                return false;
+            }
+
+            for(const auto& [Name, LhsValue] : LhsObject->Values){
+                const auto RhsValue = RhsObject->TryGetField(Name);
+
+                if(!RhsValue || bool(LhsValue) != bool(RhsValue)){
+                    return false;
+                }
+
+                if(LhsValue && !CompareEqual(*LhsValue, *RhsValue)){
+                    return false;
+                }
+            }
         }
+
+        return true;
     }
     }
+
+    return false;
 }
 
 void JsonValue::ErrorMessage(std::string_view InType) const
@@ -0,0 +1,85 @@
+#include "Serialization/JsonReader.hpp"
+
+#ifndef WITH_JSON_MMAP
+#if defined(__unix__) || defined(__APPLE__)
+#define WITH_JSON_MMAP 1
+#else
+#define WITH_JSON_MMAP 0
+#endif
+#endif // WITH_JSON_MMAP
+
+#if WITH_JSON_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif // WITH_JSON_MMAP
+
+using namespace zexjson;
+
+JsonFileReader::JsonFileReader(const std::string& InFilePath) :
+    FilePath(InFilePath), MappedData(nullptr), MappedSize(0), FallbackContent()
+{
+#if WITH_JSON_MMAP
+    const int FileDescriptor = open(FilePath.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if(FileDescriptor < 0){
+        SetErrorMessage("Unable to open file " + FilePath + ".");
+        return;
+    }
+
+    struct stat FileStat;
+
+    if(fstat(FileDescriptor, &FileStat) != 0){
+        close(FileDescriptor);
+        SetErrorMessage("Unable to stat file " + FilePath + ".");
+        return;
+    }
+
+    // Zero-length mappings are not allowed, an empty file simply has no input
+    if(FileStat.st_size > 0){
+        void* const Mapping = mmap(nullptr, static_cast<std::size_t>(FileStat.st_size), PROT_READ, MAP_PRIVATE, FileDescriptor, 0);
+
+        if(Mapping == MAP_FAILED){
+            close(FileDescriptor);
+            SetErrorMessage("Unable to map file " + FilePath + ".");
+            return;
+        }
+
+        // The tokenizer walks the file front to back exactly once
+        madvise(Mapping, static_cast<std::size_t>(FileStat.st_size), MADV_SEQUENTIAL);
+
+        MappedData = static_cast<const char*>(Mapping);
+        MappedSize = static_cast<std::size_t>(FileStat.st_size);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    close(FileDescriptor);
+#else
+    std::ifstream File(FilePath, std::ios::binary);
+
+    if(!File){
+        SetErrorMessage("Unable to open file " + FilePath + ".");
+        return;
+    }
+
+    FallbackContent.assign(std::istreambuf_iterator<char>(File), std::istreambuf_iterator<char>());
+
+    MappedData = FallbackContent.data();
+    MappedSize = FallbackContent.size();
+#endif // WITH_JSON_MMAP
+
+    Source = std::make_unique<JsonMemoryInputSource<char>>(MappedData, MappedSize);
+}
+
+JsonFileReader::~JsonFileReader()
+{
+#if WITH_JSON_MMAP
+    if(MappedData){
+        munmap(const_cast<char*>(MappedData), MappedSize);
+    }
+#endif // WITH_JSON_MMAP
+}
@@ -0,0 +1,230 @@
+#include "Serialization/JsonLinesParser.hpp"
+#include "Serialization/JsonSerializer.hpp"
+
+#include <atomic>
+
+using namespace zexjson;
+
+namespace{
+
+/** Cuts text into pieces of at least ChunkSize bytes, each ending right after a line break or at the end of the text */
+std::vector<std::string_view> SplitAtLineBreaks(std::string_view Text, const std::size_t ChunkSize)
+{
+    std::vector<std::string_view> Chunks;
+    Chunks.reserve(Text.size() / ChunkSize + 1);
+
+    while(!Text.empty()){
+        const std::size_t LineBreak = Text.size() > ChunkSize ? Text.find('\n', ChunkSize - 1) : std::string_view::npos;
+        const std::size_t Cut = LineBreak == std::string_view::npos ? Text.size() : LineBreak + 1;
+
+        Chunks.push_back(Text.substr(0, Cut));
+        Text.remove_prefix(Cut);
+    }
+
+    return Chunks;
+}
+
+/** Parses the records of one chunk, returning the reader's error message on failure */
+template<class CallbackType>
+bool ParseChunk(const std::string_view Chunk, CallbackType&& OnRecord, std::string& OutErrorMessage)
+{
+    const std::shared_ptr<JsonStringViewReader> Reader = JsonStringViewReader::Create(Chunk);
+
+    if(!JsonSerializer::DeserializeLines(*Reader, std::forward<CallbackType>(OnRecord))){
+        OutErrorMessage = Reader->GetErrorMessage();
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+JsonLinesParser::JsonLinesParser(std::size_t ThreadCount, std::size_t InChunkSize) :
+    JsonLinesParser(std::make_shared<JsonThreadPool>(ThreadCount), InChunkSize)
+{}
+
+JsonLinesParser::JsonLinesParser(std::shared_ptr<JsonThreadPool> InPool, std::size_t InChunkSize) :
+    Pool(std::move(InPool)), ChunkSize(std::max<std::size_t>(InChunkSize, 1))
+{}
+
+bool JsonLinesParser::Parse(std::string_view Text, const RecordCallback& OnRecord, EJsonLinesOrder Order)
+{
+    ErrorMessage.clear();
+
+    const std::vector<std::string_view> Chunks = SplitAtLineBreaks(Text, ChunkSize);
+
+    if(Order == EJsonLinesOrder::Ordered){
+        return ParseOrdered(Text, Chunks, OnRecord);
+    }
+
+    return ParseUnordered(Text, Chunks, OnRecord);
+}
+
+bool JsonLinesParser::ParseFile(const std::string& FilePath, const RecordCallback& OnRecord, EJsonLinesOrder Order)
+{
+    // Only used for the mapping, the text is parsed by the chunk readers
+    const std::shared_ptr<JsonFileReader> File = JsonFileReader::Create(FilePath);
+
+    if(!File->GetErrorMessage().empty()){
+        ErrorMessage = File->GetErrorMessage();
+        return false;
+    }
+
+    return Parse(File->GetSourceString(), OnRecord, Order);
+}
+
+bool JsonLinesParser::ParseOrdered(std::string_view Text, const std::vector<std::string_view>& Chunks, const RecordCallback& OnRecord)
+{
+    struct ChunkResult
+    {
+        std::vector<std::shared_ptr<JsonValue>> Records;
+        std::string ErrorMessage;
+        bool bDone = false;
+        bool bFailed = false;
+    };
+
+    std::vector<ChunkResult> Results(Chunks.size());
+
+    std::mutex Mutex;
+    std::condition_variable ChunkDone;
+    std::size_t Pending = 0;
+    std::atomic<bool> bCancelled{false};
+
+    auto SubmitChunk = [&](const std::size_t Position)
+    {
+        {
+            std::lock_guard<std::mutex> Lock(Mutex);
+            ++Pending;
+        }
+
+        Pool->Submit([&, Position]
+        {
+            ChunkResult& Result = Results[Position];
+
+            if(!bCancelled.load(std::memory_order_relaxed)){
+                Result.bFailed = !ParseChunk(Chunks[Position], [&](std::shared_ptr<JsonValue> Record)
+                {
+                    Result.Records.push_back(std::move(Record));
+                    return !bCancelled.load(std::memory_order_relaxed);
+                }, Result.ErrorMessage);
+            }
+
+            // Notified under the lock: once Pending drops to zero the caller may return and destroy it
+            std::lock_guard<std::mutex> Lock(Mutex);
+            Result.bDone = true;
+            --Pending;
+            ChunkDone.notify_all();
+        });
+    };
+
+    const std::size_t MaxAhead = std::max<std::size_t>(Pool->GetThreadCount() * ChunksAheadPerThread, 1);
+    std::size_t Submitted = 0;
+    bool bSuccess = true;
+
+    for(std::size_t Delivered{0}; Delivered < Chunks.size(); ++Delivered){
+        while(Submitted < Chunks.size() && Submitted < Delivered + MaxAhead){
+            SubmitChunk(Submitted++);
+        }
+
+        ChunkResult& Result = Results[Delivered];
+
+        {
+            std::unique_lock<std::mutex> Lock(Mutex);
+            ChunkDone.wait(Lock, [&Result]{ return Result.bDone; });
+        }
+
+        if(Result.bFailed){
+            SetChunkError(Text, Chunks[Delivered], Result.ErrorMessage);
+            bSuccess = false;
+            break;
+        }
+
+        std::vector<std::shared_ptr<JsonValue>> Records = std::move(Result.Records);
+        bool bStopped = false;
+
+        for(std::shared_ptr<JsonValue>& Record : Records){
+            if(!OnRecord(std::move(Record))){
+                bStopped = true;
+                break;
+            }
+        }
+
+        if(bStopped){
+            break;
+        }
+    }
+
+    // Chunks still queued reference this frame, so wait for them to bail out
+    bCancelled = true;
+
+    std::unique_lock<std::mutex> Lock(Mutex);
+    ChunkDone.wait(Lock, [&Pending]{ return Pending == 0; });
+
+    return bSuccess;
+}
+
+bool JsonLinesParser::ParseUnordered(std::string_view Text, const std::vector<std::string_view>& Chunks, const RecordCallback& OnRecord)
+{
+    std::mutex Mutex;
+    std::condition_variable ChunkDone;
+    std::size_t Pending = Chunks.size();
+    std::atomic<bool> bCancelled{false};
+
+    // First chunk that failed, in input order
+    std::size_t FailedChunk = Chunks.size();
+    std::string FailedMessage;
+
+    for(std::size_t Position{0}; Position < Chunks.size(); ++Position){
+        Pool->Submit([&, Position]
+        {
+            std::string ChunkError;
+            bool bFailed = false;
+
+            if(!bCancelled.load(std::memory_order_relaxed)){
+                bFailed = !ParseChunk(Chunks[Position], [&](std::shared_ptr<JsonValue> Record)
+                {
+                    if(bCancelled.load(std::memory_order_relaxed)){
+                        return false;
+                    }
+
+                    if(!OnRecord(std::move(Record))){
+                        bCancelled = true;
+                        return false;
+                    }
+
+                    return true;
+                }, ChunkError);
+            }
+
+            std::lock_guard<std::mutex> Lock(Mutex);
+
+            if(bFailed && Position < FailedChunk){
+                FailedChunk = Position;
+                FailedMessage = std::move(ChunkError);
+                bCancelled = true;
+            }
+
+            --Pending;
+            ChunkDone.notify_all();
+        });
+    }
+
+    std::unique_lock<std::mutex> Lock(Mutex);
+    ChunkDone.wait(Lock, [&Pending]{ return Pending == 0; });
+
+    if(FailedChunk != Chunks.size()){
+        SetChunkError(Text, Chunks[FailedChunk], FailedMessage);
+        return false;
+    }
+
+    return true;
+}
+
+void JsonLinesParser::SetChunkError(std::string_view Text, std::string_view Chunk, const std::string& Message)
+{
+    // Only done on failure, so counting the lines before the chunk is affordable
+    const std::size_t FirstLine = 1 + static_cast<std::size_t>(std::count(Text.data(), Chunk.data(), '\n'));
+
+    ErrorMessage = Message + " (line numbers count from line " + std::to_string(FirstLine) + " of the input)";
+}
@@ -0,0 +1,240 @@
+#include "Serialization/JsonOutputBuffer.hpp"
+#include "Serialization/JsonScanner.hpp"
+
+using namespace zexjson;
+
+namespace{
+
+constexpr char DigitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/** Formats Number right-aligned into the buffer ending at End, returning the first digit */
+inline char* FormatDigits(std::uint64_t Number, char* End)
+{
+    while(Number >= 100){
+        const std::size_t Pair = static_cast<std::size_t>(Number % 100) * 2;
+        Number /= 100;
+        End -= 2;
+        End[0] = DigitPairs[Pair];
+        End[1] = DigitPairs[Pair + 1];
+    }
+
+    if(Number >= 10){
+        const std::size_t Pair = static_cast<std::size_t>(Number) * 2;
+        End -= 2;
+        End[0] = DigitPairs[Pair];
+        End[1] = DigitPairs[Pair + 1];
+    }else{
+        *--End = static_cast<char>('0' + Number);
+    }
+
+    return End;
+}
+
+} // namespace
+
+JsonOutputBuffer::JsonOutputBuffer(std::string* InTarget, std::size_t SizeHint) :
+    Target(InTarget), Stream(nullptr), Cursor(nullptr), Limit(nullptr), bFinalized(false)
+{
+    const std::size_t Used = Target->size();
+    Target->resize(Used + std::max<std::size_t>(SizeHint, 256));
+
+    Cursor = Target->data() + Used;
+    Limit = Target->data() + Target->size();
+}
+
+JsonOutputBuffer::JsonOutputBuffer(std::ostream* InStream, std::size_t BlockSize) :
+    Target(nullptr), Stream(InStream), Block(std::max<std::size_t>(BlockSize, 64)), Cursor(Block.data()), Limit(Block.data() + Block.size()),
+    bFinalized(false)
+{}
+
+JsonOutputBuffer::JsonOutputBuffer(SinkFunction InSink, std::size_t BlockSize) :
+    Target(nullptr), Stream(nullptr), Sink(std::move(InSink)), Block(std::max<std::size_t>(BlockSize, 64)), Cursor(Block.data()), Limit(Block.data() + Block.size()),
+    bFinalized(false)
+{}
+
+JsonOutputBuffer::~JsonOutputBuffer()
+{
+    if(!Target){
+        Flush();
+        return;
+    }
+
+    // Finish a string the writer wasn't closed on, unless it was moved or changed since; it may be gone by now
+    if(!bFinalized && Target->data() + Target->size() == Limit){
+        Flush();
+    }
+}
+
+void JsonOutputBuffer::MakeRoom(std::size_t Length)
+{
+    if(!Target){
+        Flush();
+        return;
+    }
+
+    // Output after Flush() goes after whatever the string holds by then
+    const std::size_t Used = bFinalized ? Target->size() : Cursor - Target->data();
+    bFinalized = false;
+
+    Target->resize(std::max(Target->size() * 2, Used + Length));
+
+    Cursor = Target->data() + Used;
+    Limit = Target->data() + Target->size();
+}
+
+void JsonOutputBuffer::WriteSlow(const char* Data, std::size_t Length)
+{
+    if(Target){
+        MakeRoom(Length);
+        std::memcpy(Cursor, Data, Length);
+        Cursor += Length;
+        return;
+    }
+
+    // Top up the current block and pass it on, so that blocks are always full
+    while(Length > 0){
+        const std::size_t Chunk = std::min<std::size_t>(Limit - Cursor, Length);
+        std::memcpy(Cursor, Data, Chunk);
+        Cursor += Chunk;
+        Data += Chunk;
+        Length -= Chunk;
+
+        if(Cursor == Limit){
+            Flush();
+        }
+    }
+}
+
+void JsonOutputBuffer::Flush()
+{
+    if(!Target){
+        if(Cursor != Block.data()){
+            const std::size_t Length = Cursor - Block.data();
+
+            if(Sink){
+                Sink(Block.data(), Length);
+            }else{
+                Stream->write(Block.data(), static_cast<std::streamsize>(Length));
+            }
+
+            Cursor = Block.data();
+        }
+
+        return;
+    }
+
+    // The string belongs to the caller again, who may append to it, move it or let it go
+    if(bFinalized){
+        return;
+    }
+
+    const std::size_t Used = Cursor - Target->data();
+    Target->resize(Used);
+
+    Cursor = Target->data() + Used;
+    Limit = Cursor;
+    bFinalized = true;
+}
+
+bool JsonOutputBuffer::HasError() const
+{
+    return Stream && Stream->fail();
+}
+
+void JsonOutputBuffer::WriteNumber(std::int64_t Number)
+{
+    char Buffer[24];
+    char* const End = Buffer + sizeof(Buffer);
+
+    // Negate in unsigned arithmetic so that INT64_MIN doesn't overflow
+    const std::uint64_t Magnitude = Number < 0 ? 0 - static_cast<std::uint64_t>(Number) : static_cast<std::uint64_t>(Number);
+    char* Begin = FormatDigits(Magnitude, End);
+
+    if(Number < 0){
+        *--Begin = '-';
+    }
+
+    Write(Begin, End - Begin);
+}
+
+void JsonOutputBuffer::WriteNumber(std::uint64_t Number)
+{
+    char Buffer[24];
+    char* const End = Buffer + sizeof(Buffer);
+    char* const Begin = FormatDigits(Number, End);
+
+    Write(Begin, End - Begin);
+}
+
+void JsonOutputBuffer::WriteNumber(double Number)
+{
+    if(!std::isfinite(Number)){
+        // Json has no representation for infinities and NaN
+        Write("null", 4);
+        return;
+    }
+
+    char Buffer[32];
+    char* End = std::to_chars(Buffer, Buffer + sizeof(Buffer) - 2, Number).ptr;
+
+    // Keep integral doubles (and -0) reading back as doubles rather than integers
+    if(std::find_if(Buffer, End, [](const char Char){ return Char == '.' || Char == 'e'; }) == End){
+        *End++ = '.';
+        *End++ = '0';
+    }
+
+    Write(Buffer, End - Buffer);
+}
+
+void JsonOutputBuffer::WriteString(std::string_view String)
+{
+    const char* Current = String.data();
+    const char* const End = Current + String.size();
+
+    Write('\"');
+
+    while(Current != End){
+        // Copy the longest run that needs no escaping in one go
+        const char* const Special = JsonScanner::FindStringSpecial(Current, End);
+        Write(Current, Special - Current);
+
+        if(Special == End){
+            break;
+        }
+
+        const unsigned char Char = static_cast<unsigned char>(*Special);
+
+        switch (Char)
+        {
+        case '\"': Write("\\\"", 2); break;
+        case '\\': Write("\\\\", 2); break;
+        case '\b': Write("\\b", 2); break;
+        case '\f': Write("\\f", 2); break;
+        case '\n': Write("\\n", 2); break;
+        case '\r': Write("\\r", 2); break;
+        case '\t': Write("\\t", 2); break;
+
+        default:
+        {
+            static constexpr char HexDigits[] = "0123456789abcdef";
+            const char Escape[6] = {'\\', 'u', '0', '0', HexDigits[Char >> 4], HexDigits[Char & 0xF]};
+            Write(Escape, sizeof(Escape));
+            break;
+        }
+        }
+
+        Current = Special + 1;
+    }
+
+    Write('\"');
+}
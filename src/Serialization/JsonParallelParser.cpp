@@ -0,0 +1,427 @@
+#include "Serialization/JsonParallelParser.hpp"
+#include "Serialization/JsonSerializer.hpp"
+
+#include <atomic>
+
+using namespace zexjson;
+
+namespace{
+
+/** Reads a range of text and tells where in it the reader is */
+class JsonRangeReader : public JsonStringViewReader
+{
+public:
+    explicit JsonRangeReader(const std::string_view Text) :
+        JsonStringViewReader(Text)
+        {}
+
+    inline const char* GetPosition() const { return Cursor; }
+};
+
+/** An array whose elements are filled in once the workers are done with them */
+class JsonValueSplitArray : public JsonValueArray
+{
+public:
+    JsonValueSplitArray() :
+        JsonValueArray(JsonArray())
+        {}
+
+    void Append(JsonArray&& Elements)
+    {
+        if(Value.empty()){
+            Value = std::move(Elements);
+        }else{
+            Value.insert(Value.end(), std::make_move_iterator(Elements.begin()), std::make_move_iterator(Elements.end()));
+        }
+    }
+};
+
+/** Appends where the element an error was found in starts, as its reader counts positions from there */
+std::string LocateElementError(const std::string_view Text, const char* const Element, const std::string& Message)
+{
+    // Only done on failure, so counting the lines before the element is affordable
+    const std::size_t FirstLine = 1 + static_cast<std::size_t>(std::count(Text.data(), Element, '\n'));
+
+    const std::size_t LineStart = Text.find_last_of('\n', static_cast<std::size_t>(Element - Text.data()));
+    const std::size_t Character = static_cast<std::size_t>(Element - Text.data()) - (LineStart == std::string_view::npos ? 0 : LineStart + 1);
+
+    return Message + " (positions count from the element at line " + std::to_string(FirstLine) + " Ch: " + std::to_string(Character) + " of the input)";
+}
+
+/** Consecutive elements of a split array, parsed by one task */
+struct ElementBatch
+{
+    /** Shared, since the tree may drop the array before its elements are in, e.g. for a duplicate key */
+    std::shared_ptr<JsonValueSplitArray> Target;
+
+    /** Position of the batch in the document */
+    std::size_t Position = 0;
+
+    /** One slot per element; scalars are filled in while splitting, containers by the task */
+    JsonArray Values;
+
+    /** Slot and text of each container element */
+    std::vector<std::pair<std::size_t, std::string_view>> Ranges;
+
+    std::size_t Bytes = 0;
+
+    // Set by the task on failure: the reader's message and where the failing element starts
+    std::string ErrorMessage;
+    const char* ErrorElement = nullptr;
+};
+
+/** Batches the elements of split arrays, runs them on the pool and puts the results in place */
+class JsonSplitJob
+{
+public:
+    JsonSplitJob(JsonThreadPool& InPool, const std::size_t InChunkSize) :
+        Pool(InPool), ChunkSize(InChunkSize), Pending(0), FirstFailure(NoFailure), bOpen(false)
+        {}
+
+    JsonSplitJob(const JsonSplitJob&) = delete;
+    JsonSplitJob& operator=(const JsonSplitJob&) = delete;
+
+    /** Queued tasks refer to the job, so it can't go before they do */
+    ~JsonSplitJob()
+    {
+        FirstFailure = 0;
+        Wait();
+    }
+
+    void BeginArray(std::shared_ptr<JsonValueSplitArray> Target)
+    {
+        CurrentTarget = std::move(Target);
+    }
+
+    void AddValue(std::shared_ptr<JsonValue> Value)
+    {
+        OpenBatch().Values.push_back(std::move(Value));
+    }
+
+    void AddRange(const std::string_view Text)
+    {
+        ElementBatch& Batch = OpenBatch();
+
+        Batch.Ranges.emplace_back(Batch.Values.size(), Text);
+        Batch.Values.emplace_back();
+        Batch.Bytes += Text.size();
+
+        if(Batch.Bytes >= ChunkSize){
+            SubmitOpenBatch();
+        }
+    }
+
+    void EndArray()
+    {
+        if(bOpen){
+            SubmitOpenBatch();
+        }
+
+        CurrentTarget.reset();
+    }
+
+    /** Returns true once a task failed, so splitting can stop */
+    inline bool HasFailed() const
+    {
+        return FirstFailure.load(std::memory_order_relaxed) != NoFailure;
+    }
+
+    /**
+     * Waits for every task, then moves the elements into their arrays.
+     *
+     * @return @c false if a task failed, with the message of the first failure in document order.
+    */
+    bool Finish(const std::string_view Text, std::string& OutErrorMessage)
+    {
+        Wait();
+
+        for(ElementBatch& Batch : Batches){
+            if(Batch.ErrorElement != nullptr){
+                OutErrorMessage = LocateElementError(Text, Batch.ErrorElement, Batch.ErrorMessage);
+                return false;
+            }
+        }
+
+        for(ElementBatch& Batch : Batches){
+            Batch.Target->Append(std::move(Batch.Values));
+        }
+
+        Batches.clear();
+        return true;
+    }
+
+protected:
+    ElementBatch& OpenBatch()
+    {
+        if(!bOpen){
+            // A deque, so batches being parsed stay where they are as more are added
+            ElementBatch& Batch = Batches.emplace_back();
+            Batch.Target = CurrentTarget;
+            Batch.Position = Batches.size() - 1;
+            bOpen = true;
+        }
+
+        return Batches.back();
+    }
+
+    void SubmitOpenBatch()
+    {
+        ElementBatch& Batch = Batches.back();
+        bOpen = false;
+
+        if(Batch.Ranges.empty()){
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> Lock(Mutex);
+            ++Pending;
+        }
+
+        Pool.Submit([this, &Batch]
+        {
+            for(const auto& [Slot, Text] : Batch.Ranges){
+                // Batches before a failure go on, so the error reported is always the first in the document
+                if(Batch.Position > FirstFailure.load(std::memory_order_relaxed)){
+                    break;
+                }
+
+                JsonRangeReader Reader(Text);
+
+                if(!JsonSerializer::Deserialize(Reader, Batch.Values[Slot])){
+                    Batch.ErrorMessage = Reader.GetErrorMessage();
+                    Batch.ErrorElement = Text.data();
+
+                    std::size_t Failure = FirstFailure.load();
+                    while(Batch.Position < Failure && !FirstFailure.compare_exchange_weak(Failure, Batch.Position)){}
+                    break;
+                }
+            }
+
+            // Notified under the lock: once Pending drops to zero the job may be destroyed
+            std::lock_guard<std::mutex> Lock(Mutex);
+            --Pending;
+            Done.notify_all();
+        });
+    }
+
+    void Wait()
+    {
+        std::unique_lock<std::mutex> Lock(Mutex);
+        Done.wait(Lock, [this]{ return Pending == 0; });
+    }
+
+    JsonThreadPool& Pool;
+    std::size_t ChunkSize;
+
+    std::deque<ElementBatch> Batches;
+    std::shared_ptr<JsonValueSplitArray> CurrentTarget;
+
+    std::mutex Mutex;
+    std::condition_variable Done;
+    std::size_t Pending;
+
+    static constexpr std::size_t NoFailure = std::numeric_limits<std::size_t>::max();
+    std::atomic<std::size_t> FirstFailure;
+
+    // Whether Batches.back() still takes elements
+    bool bOpen;
+};
+
+std::shared_ptr<JsonValue> MakeNumber(const JsonRangeReader& Reader)
+{
+    switch (Reader.GetValueNumberType())
+    {
+    case EJsonNumber::Int64:
+        return std::make_shared<JsonValueNumber>(Reader.GetValueAsInt64());
+
+    case EJsonNumber::UInt64:
+        return std::make_shared<JsonValueNumber>(Reader.GetValueAsUInt64());
+
+    default:
+        return std::make_shared<JsonValueNumber>(Reader.GetValueAsNumber());
+    }
+}
+
+} // namespace
+
+JsonParallelParser::JsonParallelParser(std::size_t ThreadCount, std::size_t InChunkSize) :
+    JsonParallelParser(std::make_shared<JsonThreadPool>(ThreadCount), InChunkSize)
+{}
+
+JsonParallelParser::JsonParallelParser(std::shared_ptr<JsonThreadPool> InPool, std::size_t InChunkSize) :
+    Pool(std::move(InPool)), ChunkSize(std::max<std::size_t>(InChunkSize, 1)), SplitDepth(0)
+{}
+
+bool JsonParallelParser::Parse(std::string_view Text, std::shared_ptr<JsonValue>& OutValue)
+{
+    struct StackFrame
+    {
+        EJson Type;
+        JsonName Identifier;
+        JsonArray Array;
+        std::shared_ptr<JsonObject> Object;
+        std::shared_ptr<JsonValueSplitArray> Split;
+    };
+
+    ErrorMessage.clear();
+
+    JsonRangeReader Reader(Text);
+    JsonSplitJob Job(*Pool, ChunkSize);
+
+    std::vector<StackFrame> Stack;
+    std::shared_ptr<JsonValue> Root;
+    EJsonNotation Notation;
+
+    // Element of a split array that couldn't be skipped over
+    const char* FailedElement = nullptr;
+
+    while(Reader.ReadNext(Notation)){
+        const bool bInSplit = !Stack.empty() && Stack.back().Split;
+
+        if(bInSplit && (Notation == EJsonNotation::ObjectStart || Notation == EJsonNotation::ArrayStart)){
+            // The opening bracket was the last character read
+            const char* const Begin = Reader.GetPosition() - 1;
+
+            if(!(Notation == EJsonNotation::ObjectStart ? Reader.SkipObject() : Reader.SkipArray())){
+                FailedElement = Begin;
+                break;
+            }
+
+            Job.AddRange(std::string_view(Begin, static_cast<std::size_t>(Reader.GetPosition() - Begin)));
+
+            if(Job.HasFailed()){
+                break;
+            }
+
+            continue;
+        }
+
+        JsonName Identifier(Reader.GetIdentifierView());
+        std::shared_ptr<JsonValue> NewValue;
+
+        switch (Notation)
+        {
+        case EJsonNotation::ObjectStart:
+        case EJsonNotation::ArrayStart:
+        {
+            const bool bSplit = Notation == EJsonNotation::ArrayStart && Stack.size() == SplitDepth;
+
+            StackFrame& Frame = Stack.emplace_back();
+            Frame.Identifier = std::move(Identifier);
+
+            if(Notation == EJsonNotation::ObjectStart){
+                Frame.Type = EJson::Object;
+                Frame.Object = std::make_shared<JsonObject>();
+            }else{
+                Frame.Type = EJson::Array;
+
+                if(bSplit){
+                    Frame.Split = std::make_shared<JsonValueSplitArray>();
+                    Job.BeginArray(Frame.Split);
+                }
+            }
+
+            continue;
+        }
+
+        case EJsonNotation::ObjectEnd:
+        case EJsonNotation::ArrayEnd:
+        {
+            StackFrame& Frame = Stack.back();
+
+            if(Frame.Split){
+                Job.EndArray();
+                NewValue = std::move(Frame.Split);
+            }else if(Frame.Type == EJson::Object){
+                NewValue = std::make_shared<JsonValueObject>(std::move(Frame.Object));
+            }else{
+                NewValue = std::make_shared<JsonValueArray>(std::move(Frame.Array));
+            }
+
+            Identifier = std::move(Frame.Identifier);
+            Stack.pop_back();
+            break;
+        }
+
+        case EJsonNotation::String:
+            NewValue = std::make_shared<JsonValueString>(Reader.GetValueAsStringView());
+            break;
+
+        case EJsonNotation::Number:
+            NewValue = MakeNumber(Reader);
+            break;
+
+        case EJsonNotation::Boolean:
+            NewValue = std::make_shared<JsonValueBoolean>(Reader.GetValueAsBoolean());
+            break;
+
+        case EJsonNotation::Null:
+            NewValue = std::make_shared<JsonValueNull>();
+            break;
+
+        case EJsonNotation::Error:
+            break;
+        }
+
+        if(Notation == EJsonNotation::Error){
+            break;
+        }
+
+        // Like JsonSerializer::Deserialize(), only white space may follow the root
+        if(Stack.empty()){
+            Root = std::move(NewValue);
+            Reader.ReadNext(Notation);
+            break;
+        }
+
+        StackFrame& Parent = Stack.back();
+
+        if(Parent.Split){
+            Job.AddValue(std::move(NewValue));
+        }else if(Parent.Type == EJson::Object){
+            Parent.Object->Values.insert_or_assign(std::move(Identifier), std::move(NewValue));
+        }else{
+            Parent.Array.push_back(std::move(NewValue));
+        }
+    }
+
+    const bool bSplitFailed = !Reader.GetErrorMessage().empty() || !Root;
+
+    // Elements handed out come before where splitting stopped, so their errors come first
+    if(!Job.Finish(Text, ErrorMessage)){
+        return false;
+    }
+
+    if(bSplitFailed){
+        ErrorMessage = Reader.GetErrorMessage().empty() ? "Improperly formatted." : Reader.GetErrorMessage();
+
+        // Skipping only tracks brackets and strings, so the element is read again for the exact error
+        if(FailedElement != nullptr){
+            JsonRangeReader ElementReader(Text.substr(static_cast<std::size_t>(FailedElement - Text.data())));
+            std::shared_ptr<JsonValue> Element;
+
+            if(!JsonSerializer::Deserialize(ElementReader, Element)){
+                ErrorMessage = LocateElementError(Text, FailedElement, ElementReader.GetErrorMessage());
+            }
+        }
+
+        return false;
+    }
+
+    OutValue = std::move(Root);
+    return true;
+}
+
+bool JsonParallelParser::ParseFile(const std::string& FilePath, std::shared_ptr<JsonValue>& OutValue)
+{
+    // Only used for the mapping, the text is parsed by the parser's own readers
+    const std::shared_ptr<JsonFileReader> File = JsonFileReader::Create(FilePath);
+
+    if(!File->GetErrorMessage().empty()){
+        ErrorMessage = File->GetErrorMessage();
+        return false;
+    }
+
+    return Parse(File->GetSourceString(), OutValue);
+}
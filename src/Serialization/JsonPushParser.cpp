@@ -0,0 +1,138 @@
+#include "Serialization/JsonPushParser.hpp"
+
+using namespace zexjson;
+
+namespace{
+
+/** Creates a number value, keeping integers exact */
+std::shared_ptr<JsonValue> MakeNumber(const JsonPushReader& Reader)
+{
+    switch (Reader.GetValueNumberType())
+    {
+    case EJsonNumber::Int64:
+        return std::make_shared<JsonValueNumber>(Reader.GetValueAsInt64());
+
+    case EJsonNumber::UInt64:
+        return std::make_shared<JsonValueNumber>(Reader.GetValueAsUInt64());
+
+    default:
+        return std::make_shared<JsonValueNumber>(Reader.GetValueAsNumber());
+    }
+}
+
+} // namespace
+
+JsonPushParser::JsonPushParser() :
+    Reader(JsonPushReader::Create()), Stack(), Root()
+{}
+
+bool JsonPushParser::Feed(const char* Data, std::size_t Length)
+{
+    if(!Reader->GetErrorMessage().empty()){
+        return false;
+    }
+
+    Reader->Feed(Data, Length);
+    return ReadAvailable();
+}
+
+bool JsonPushParser::Finish(std::shared_ptr<JsonValue>& OutValue)
+{
+    Reader->EndInput();
+
+    if(!ReadAvailable() || !Root){
+        return false;
+    }
+
+    OutValue = std::move(Root);
+    return true;
+}
+
+bool JsonPushParser::ReadAvailable()
+{
+    EJsonNotation Notation;
+
+    while(true){
+        const EJsonPushStatus Status = Reader->ReadNext(Notation);
+
+        if(Status == EJsonPushStatus::NeedMoreData || Status == EJsonPushStatus::Finished){
+            return true;
+        }
+
+        if(Status == EJsonPushStatus::Error){
+            return false;
+        }
+
+        JsonName Identifier(Reader->GetIdentifierView());
+        std::shared_ptr<JsonValue> NewValue;
+
+        switch (Notation)
+        {
+        case EJsonNotation::ObjectStart:
+        case EJsonNotation::ArrayStart:
+        {
+            StackFrame& Frame = Stack.emplace_back();
+            Frame.Identifier = std::move(Identifier);
+
+            if(Notation == EJsonNotation::ObjectStart){
+                Frame.Type = EJson::Object;
+                Frame.Object = std::make_shared<JsonObject>();
+            }else{
+                Frame.Type = EJson::Array;
+            }
+
+            continue;
+        }
+
+        case EJsonNotation::ObjectEnd:
+        case EJsonNotation::ArrayEnd:
+        {
+            StackFrame& Frame = Stack.back();
+            Identifier = std::move(Frame.Identifier);
+
+            if(Frame.Type == EJson::Object){
+                NewValue = std::make_shared<JsonValueObject>(std::move(Frame.Object));
+            }else{
+                NewValue = std::make_shared<JsonValueArray>(std::move(Frame.Array));
+            }
+
+            Stack.pop_back();
+
+            if(Stack.empty()){
+                Root = std::move(NewValue);
+                continue;
+            }
+
+            break;
+        }
+
+        case EJsonNotation::String:
+            NewValue = std::make_shared<JsonValueString>(Reader->GetValueAsStringView());
+            break;
+
+        case EJsonNotation::Number:
+            NewValue = MakeNumber(*Reader);
+            break;
+
+        case EJsonNotation::Boolean:
+            NewValue = std::make_shared<JsonValueBoolean>(Reader->GetValueAsBoolean());
+            break;
+
+        case EJsonNotation::Null:
+            NewValue = std::make_shared<JsonValueNull>();
+            break;
+
+        default:
+            return false;
+        }
+
+        // The reader only hands out values inside the root
+        StackFrame& Parent = Stack.back();
+
+        if(Parent.Type == EJson::Object){
+            Parent.Object->Values.insert_or_assign(std::move(Identifier), std::move(NewValue));
+        }else{
+            Parent.Array.push_back(std::move(NewValue));
+        }
+    }
+}
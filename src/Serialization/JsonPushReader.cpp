@@ -0,0 +1,543 @@
+#include "Serialization/JsonPushReader.hpp"
+
+using namespace zexjson;
+
+JsonPushReader::JsonPushReader() :
+    ScanState(EScanState::None), Step(EGrammarStep::Start), NumberState(0), HexDigitCount(0), HexValue(0), HighSurrogate(0),
+    TokenStart(nullptr), bTokenCopied(false), bReadInProgress(false), bInputEnded(false), Literal(), Backlog()
+{
+    // Every token is read straight out of the piece it lies in
+    bContiguousInput = true;
+}
+
+void JsonPushReader::Feed(const char* Data, std::size_t Length)
+{
+    if(bInputEnded || !ErrorMessage.empty() || Length == 0){
+        return;
+    }
+
+    if(Cursor == BufferEnd){
+        Cursor = Data;
+        BufferEnd = Data + Length;
+        return;
+    }
+
+    // Input is only left over between tokens, but the last value read may lie in the backlog this replaces
+    DetachFromInput();
+
+    std::string Joined;
+    Joined.reserve(static_cast<std::size_t>(BufferEnd - Cursor) + Length);
+    Joined.append(Cursor, BufferEnd);
+    Joined.append(Data, Length);
+    Backlog.swap(Joined);
+
+    Cursor = Backlog.data();
+    BufferEnd = Cursor + Backlog.size();
+}
+
+void JsonPushReader::EndInput()
+{
+    bInputEnded = true;
+}
+
+EJsonPushStatus JsonPushReader::ReadNext(EJsonNotation& Notation)
+{
+    if(!ErrorMessage.empty()){
+        Notation = EJsonNotation::Error;
+        return EJsonPushStatus::Error;
+    }
+
+    if(FinishedReadingRootObject){
+        SkipWhiteSpace();
+
+        if(Cursor != BufferEnd){
+            Notation = EJsonNotation::Error;
+            SetErrorMessage("Unexpected additional input found.");
+            return EJsonPushStatus::Error;
+        }
+
+        return EJsonPushStatus::Finished;
+    }
+
+    // A notation cut short keeps the identifier it has read so far
+    if(!bReadInProgress){
+        Identifier.clear();
+        IdentifierView = std::string_view();
+        bIdentifierInSource = false;
+    }
+
+    while(true){
+        const EJson Container = ParseState.empty() ? EJson::None : ParseState.back();
+        EJsonToken Token = EJsonToken::None;
+        const EJsonPushStatus Status = ScanToken(Token);
+
+        if(Status == EJsonPushStatus::NeedMoreData){
+            // The identifier may lie in the piece that is used up, the last value is no longer needed
+            if(bIdentifierInSource){
+                GetIdentifier();
+            }
+
+            if(bStringInSource){
+                StringView = std::string_view();
+                bStringInSource = false;
+            }
+
+            bReadInProgress = true;
+            return Status;
+        }
+
+        if(Status != EJsonPushStatus::Ready){
+            Notation = EJsonNotation::Error;
+            return Status;
+        }
+
+        switch (Step)
+        {
+        case EGrammarStep::Start:
+            if(Token != EJsonToken::CurlyOpen && Token != EJsonToken::SquareOpen){
+                Notation = EJsonNotation::Error;
+                SetErrorMessage("Open Curly or Square Brace token expected, but not found.");
+                return EJsonPushStatus::Error;
+            }
+
+            return EmitToken(Token, Notation);
+
+        case EGrammarStep::Key:
+            if(Token != EJsonToken::String){
+                Notation = EJsonNotation::Error;
+                SetErrorMessage("String token expected, but not found.");
+                return EJsonPushStatus::Error;
+            }
+
+            TakeIdentifier();
+            Step = EGrammarStep::Colon;
+            break;
+
+        case EGrammarStep::Colon:
+            if(Token != EJsonToken::Colon){
+                Notation = EJsonNotation::Error;
+                SetErrorMessage("Colon token expected, but not found.");
+                return EJsonPushStatus::Error;
+            }
+
+            Step = EGrammarStep::Value;
+            break;
+
+        case EGrammarStep::Value:
+            // Like JsonReader, accept a trailing comma before the closing bracket of an array
+            if(Token == EJsonToken::SquareClose && Container == EJson::Array){
+                Step = EGrammarStep::Next;
+            }
+
+            return EmitToken(Token, Notation);
+
+        case EGrammarStep::Next:
+        {
+            const bool bObject = Container == EJson::Object;
+            const EJsonToken CloseToken = bObject ? EJsonToken::CurlyClose : EJsonToken::SquareClose;
+
+            if(Token == CloseToken){
+                return EmitToken(Token, Notation);
+            }
+
+            // Only the first member of a container isn't preceded by a comma
+            const bool bCommaPrepend = CurrentToken != (bObject ? EJsonToken::CurlyOpen : EJsonToken::SquareOpen);
+
+            if(bCommaPrepend){
+                if(Token != EJsonToken::Comma){
+                    Notation = EJsonNotation::Error;
+                    SetErrorMessage("Comma token expected, but not found.");
+                    return EJsonPushStatus::Error;
+                }
+
+                Step = bObject ? EGrammarStep::Key : EGrammarStep::Value;
+                break;
+            }
+
+            if(!bObject){
+                return EmitToken(Token, Notation);
+            }
+
+            if(Token != EJsonToken::String){
+                Notation = EJsonNotation::Error;
+                SetErrorMessage("String token expected, but not found.");
+                return EJsonPushStatus::Error;
+            }
+
+            TakeIdentifier();
+            Step = EGrammarStep::Colon;
+            break;
+        }
+        }
+    }
+}
+
+EJsonPushStatus JsonPushReader::ScanToken(EJsonToken& OutToken)
+{
+    if(ScanState == EScanState::None){
+        SkipWhiteSpace();
+
+        if(Cursor == BufferEnd){
+            const bool bBetweenNotations = Step == EGrammarStep::Start || Step == EGrammarStep::Next;
+            return AtEndOfPiece(bBetweenNotations ? "Improperly formatted." : "Invalid Json Token.");
+        }
+
+        const char Char = *Cursor++;
+        ++CharacterNumber;
+
+        if(IsJsonNumber(Char)){
+            NumberState = NextNumberState(0, Char);
+
+            if(NumberState < 0){
+                SetErrorMessage("Poorly formed Json Number token.");
+                return EJsonPushStatus::Error;
+            }
+
+            TokenStart = Cursor - 1;
+            bTokenCopied = false;
+            bStringInSource = false;
+            StringValue.clear();
+            ScanState = EScanState::Number;
+        }else{
+            switch (Char)
+            {
+            case '{': OutToken = EJsonToken::CurlyOpen; return EJsonPushStatus::Ready;
+            case '}': OutToken = EJsonToken::CurlyClose; return EJsonPushStatus::Ready;
+            case '[': OutToken = EJsonToken::SquareOpen; return EJsonPushStatus::Ready;
+            case ']': OutToken = EJsonToken::SquareClose; return EJsonPushStatus::Ready;
+            case ':': OutToken = EJsonToken::Colon; return EJsonPushStatus::Ready;
+            case ',': OutToken = EJsonToken::Comma; return EJsonPushStatus::Ready;
+
+            case '\"':
+                bTokenCopied = false;
+                bStringInSource = false;
+                HighSurrogate = 0;
+                StringValue.clear();
+                ScanState = EScanState::String;
+                break;
+
+            case 't': case 'T':
+            case 'f': case 'F':
+            case 'n': case 'N':
+                Literal.assign(1, Char);
+                ScanState = EScanState::Literal;
+                break;
+
+            default:
+                SetErrorMessage("Invalid Json Token.");
+                return EJsonPushStatus::Error;
+            }
+        }
+    }
+
+    switch (ScanState)
+    {
+    case EScanState::Number:
+        return ScanNumber(OutToken);
+
+    case EScanState::Literal:
+        return ScanLiteral(OutToken);
+
+    default:
+        return ScanString(OutToken);
+    }
+}
+
+EJsonPushStatus JsonPushReader::ScanString(EJsonToken& OutToken)
+{
+    while(true){
+        if(ScanState == EScanState::String){
+            const char* const RunStart = Cursor;
+            Cursor = JsonScanner::FindStringSpecial(Cursor, BufferEnd);
+            CharacterNumber += static_cast<std::uint32_t>(Cursor - RunStart);
+
+            if(HighSurrogate != 0 && Cursor != RunStart){
+                SetErrorMessage("Unpaired UTF-16 surrogate in string.");
+                return EJsonPushStatus::Error;
+            }
+
+            if(Cursor == BufferEnd){
+                StringValue.append(RunStart, Cursor);
+                bTokenCopied = true;
+                return AtEndOfPiece("String Token Abruptly Ended.");
+            }
+
+            const char Char = *Cursor++;
+            ++CharacterNumber;
+
+            if(Char == '\"'){
+                if(HighSurrogate != 0){
+                    SetErrorMessage("Unpaired UTF-16 surrogate in string.");
+                    return EJsonPushStatus::Error;
+                }
+
+                // A string without escapes within one piece is handed out as a view into it
+                if(!bTokenCopied){
+                    StringView = std::string_view(RunStart, Cursor - 1 - RunStart);
+                    bStringInSource = true;
+                }else{
+                    StringValue.append(RunStart, Cursor - 1);
+                    StringView = StringValue;
+                    bStringInSource = false;
+                }
+
+                ScanState = EScanState::None;
+                OutToken = EJsonToken::String;
+                return EJsonPushStatus::Ready;
+            }
+
+            StringValue.append(RunStart, Cursor - 1);
+            bTokenCopied = true;
+
+            if(Char != '\\'){
+                SetErrorMessage("Unescaped control character in string.");
+                return EJsonPushStatus::Error;
+            }
+
+            ScanState = EScanState::StringEscape;
+        }
+
+        if(Cursor == BufferEnd){
+            return AtEndOfPiece("String Token Abruptly Ended.");
+        }
+
+        if(ScanState == EScanState::StringEscape){
+            const char Char = *Cursor++;
+            ++CharacterNumber;
+            ScanState = EScanState::String;
+
+            if(HighSurrogate != 0 && Char != 'u'){
+                SetErrorMessage("Unpaired UTF-16 surrogate in string.");
+                return EJsonPushStatus::Error;
+            }
+
+            switch (Char)
+            {
+            case '\"': case '\\': case '/': StringValue += Char; break;
+            case 'f': StringValue += '\f'; break;
+            case 'r': StringValue += '\r'; break;
+            case 'n': StringValue += '\n'; break;
+            case 'b': StringValue += '\b'; break;
+            case 't': StringValue += '\t'; break;
+            case 'u':
+                HexDigitCount = 0;
+                HexValue = 0;
+                ScanState = EScanState::StringUnicode;
+                break;
+            default:
+                SetErrorMessage("Bad Json escaped char.");
+                return EJsonPushStatus::Error;
+            }
+        }
+
+        if(ScanState == EScanState::StringUnicode){
+            // 4 hex digits, which may arrive in separate pieces
+            for(; HexDigitCount < 4; ++HexDigitCount){
+                if(Cursor == BufferEnd){
+                    return AtEndOfPiece("String token abruptly ended.");
+                }
+
+                const char Char = *Cursor++;
+                ++CharacterNumber;
+
+                const std::int32_t HexDigit = JsonUtils::ParseHexDigit(Char);
+
+                if(HexDigit == 0 && Char != '0'){
+                    SetErrorMessage("Invalid hexadecimal digit parsed.");
+                    return EJsonPushStatus::Error;
+                }
+
+                HexValue = (HexValue << 4) | static_cast<std::uint32_t>(HexDigit);
+            }
+
+            if(!JsonUtils::AppendUtf16Unit(StringValue, HexValue, HighSurrogate)){
+                SetErrorMessage("Unpaired UTF-16 surrogate in string.");
+                return EJsonPushStatus::Error;
+            }
+
+            ScanState = EScanState::String;
+        }
+    }
+}
+
+EJsonPushStatus JsonPushReader::ScanNumber(EJsonToken& OutToken)
+{
+    const char* const RunStart = bTokenCopied ? Cursor : TokenStart;
+
+    while(Cursor != BufferEnd && IsJsonNumber(*Cursor)){
+        NumberState = NextNumberState(NumberState, *Cursor++);
+        ++CharacterNumber;
+
+        if(NumberState < 0){
+            SetErrorMessage("Poorly formed Json Number token.");
+            return EJsonPushStatus::Error;
+        }
+    }
+
+    // The number may go on in the next piece
+    if(Cursor == BufferEnd){
+        StringValue.append(RunStart, Cursor);
+        bTokenCopied = true;
+        return AtEndOfPiece("Number token abruptly ended.");
+    }
+
+    ScanState = EScanState::None;
+
+    if(!IsNumberComplete(NumberState)){
+        SetErrorMessage("Poorly formed Json Number token.");
+        return EJsonPushStatus::Error;
+    }
+
+    if(!bTokenCopied){
+        StringView = std::string_view(RunStart, Cursor - RunStart);
+        bStringInSource = true;
+    }else{
+        StringValue.append(RunStart, Cursor);
+        StringView = StringValue;
+        bStringInSource = false;
+    }
+
+    if(!ConvertNumberToken(StringView, NumberState == 2 || NumberState == 3)){
+        return EJsonPushStatus::Error;
+    }
+
+    OutToken = EJsonToken::Number;
+    return EJsonPushStatus::Ready;
+}
+
+EJsonPushStatus JsonPushReader::ScanLiteral(EJsonToken& OutToken)
+{
+    while(Cursor != BufferEnd && IsAlphaNumber(*Cursor)){
+        Literal += *Cursor++;
+        ++CharacterNumber;
+    }
+
+    // The literal may go on in the next piece, unless there is none
+    if(Cursor == BufferEnd && !bInputEnded){
+        return EJsonPushStatus::NeedMoreData;
+    }
+
+    ScanState = EScanState::None;
+
+    if(JsonUtils::EqualsIgnoreCase(Literal, "False")){
+        BoolValue = false;
+        OutToken = EJsonToken::False;
+        return EJsonPushStatus::Ready;
+    }
+
+    if(JsonUtils::EqualsIgnoreCase(Literal, "True")){
+        BoolValue = true;
+        OutToken = EJsonToken::True;
+        return EJsonPushStatus::Ready;
+    }
+
+    if(JsonUtils::EqualsIgnoreCase(Literal, "Null")){
+        OutToken = EJsonToken::Null;
+        return EJsonPushStatus::Ready;
+    }
+
+    SetErrorMessage("Invalid Json Token. Check that your member names have quotes around them!");
+    return EJsonPushStatus::Error;
+}
+
+EJsonPushStatus JsonPushReader::AtEndOfPiece(const char* Message)
+{
+    if(bInputEnded){
+        SetErrorMessage(Message);
+        return EJsonPushStatus::Error;
+    }
+
+    return EJsonPushStatus::NeedMoreData;
+}
+
+EJsonPushStatus JsonPushReader::EmitToken(EJsonToken Token, EJsonNotation& Notation)
+{
+#if WITH_JSON_INLINED_NOTATIONMAP
+    JSON_NOTATIONMAP_DEF;
+#endif // WITH_JSON_INLINED_NOTATIONMAP
+
+    Notation = TokenToNotationTable[(std::int32_t)Token];
+
+    switch (Token)
+    {
+    case EJsonToken::CurlyOpen:
+        ParseState.push_back(EJson::Object);
+        break;
+
+    case EJsonToken::SquareOpen:
+        ParseState.push_back(EJson::Array);
+        break;
+
+    case EJsonToken::CurlyClose:
+    case EJsonToken::SquareClose:
+        // Only emitted where ReadNext() found them to close the innermost container
+        if(Step == EGrammarStep::Next){
+            ParseState.pop_back();
+            break;
+        }
+
+        Notation = EJsonNotation::Error;
+        break;
+
+    default:
+        break;
+    }
+
+    if(Notation == EJsonNotation::Error){
+        SetErrorMessage("Unknown Error Occured");
+        return EJsonPushStatus::Error;
+    }
+
+    CurrentToken = Token;
+    FinishedReadingRootObject = ParseState.empty();
+    Step = EGrammarStep::Next;
+    bReadInProgress = false;
+
+    return EJsonPushStatus::Ready;
+}
+
+void JsonPushReader::TakeIdentifier()
+{
+    if(bStringInSource){
+        IdentifierView = StringView;
+        bIdentifierInSource = true;
+        bStringInSource = false;
+    }else{
+        Identifier.swap(StringValue);
+        IdentifierView = Identifier;
+        bIdentifierInSource = false;
+    }
+
+    StringView = std::string_view();
+}
+
+void JsonPushReader::SkipWhiteSpace()
+{
+    while(Cursor != BufferEnd && IsWhitespace(*Cursor)){
+        std::uint32_t LineBreaks = 0;
+        const char* LastLineBreak = nullptr;
+        const char* RunEnd = JsonScanner::SkipWhitespace(Cursor, BufferEnd, LineBreaks, LastLineBreak);
+
+        if(LineBreaks){
+            LineNumber += LineBreaks;
+            CharacterNumber = static_cast<std::uint32_t>(RunEnd - LastLineBreak - 1);
+        }else{
+            CharacterNumber += static_cast<std::uint32_t>(RunEnd - Cursor);
+        }
+
+        Cursor = RunEnd;
+    }
+}
+
+void JsonPushReader::DetachFromInput()
+{
+    if(bIdentifierInSource){
+        GetIdentifier();
+    }
+
+    if(bStringInSource){
+        StringValue.assign(StringView);
+        StringView = StringValue;
+        bStringInSource = false;
+    }
+}
@@ -0,0 +1,745 @@
+#include "Serialization/JsonScanner.hpp"
+
+#include <atomic>
+
+#ifndef WITH_JSON_SIMD
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define WITH_JSON_SIMD 1
+#else
+#define WITH_JSON_SIMD 0
+#endif
+#endif // WITH_JSON_SIMD
+
+#if WITH_JSON_SIMD
+#include <immintrin.h>
+#endif // WITH_JSON_SIMD
+
+using namespace zexjson;
+
+namespace{
+
+using FindStringSpecialFunc = const char* (*)(const char*, const char*);
+using SkipWhitespaceFunc = const char* (*)(const char*, const char*, std::uint32_t&, const char*&);
+using FindStructuralFunc = const char* (*)(const char*, const char*);
+using SkipContainerBlocksFunc = const char* (*)(const char*, const char*, JsonSkipState&);
+using BuildStructuralIndexFunc = void (*)(const char*, const char*, std::vector<std::uint32_t>&);
+
+inline bool IsStringSpecial(const char Char)
+{
+    return Char == '\"' || Char == '\\' || static_cast<unsigned char>(Char) < 0x20;
+}
+
+inline bool IsWhitespace(const char Char)
+{
+    return Char == ' ' || Char == '\t' || Char == '\n' || Char == '\r';
+}
+
+inline bool IsStructural(const char Char)
+{
+    return Char == '\"' || Char == '{' || Char == '}' || Char == '[' || Char == ']' || Char == '\n';
+}
+
+const char* FindStringSpecialScalar(const char* Begin, const char* End)
+{
+    while(Begin != End && !IsStringSpecial(*Begin)){
+        ++Begin;
+    }
+
+    return Begin;
+}
+
+const char* SkipWhitespaceScalar(const char* Begin, const char* End, std::uint32_t& OutLineBreaks, const char*& OutLastLineBreak)
+{
+    OutLineBreaks = 0;
+
+    while(Begin != End && IsWhitespace(*Begin)){
+        if(*Begin == '\n'){
+            ++OutLineBreaks;
+            OutLastLineBreak = Begin;
+        }
+
+        ++Begin;
+    }
+
+    return Begin;
+}
+
+const char* FindStructuralScalar(const char* Begin, const char* End)
+{
+    while(Begin != End && !IsStructural(*Begin)){
+        ++Begin;
+    }
+
+    return Begin;
+}
+
+const char* SkipContainerBlocksScalar(const char* Begin, const char* /* End */, JsonSkipState& State)
+{
+    // Classifying a block one character at a time is no faster than the caller's own loop
+    State.LineBreaks = 0;
+    return Begin;
+}
+
+/** Sets every bit from each set bit up to the next one, i.e. marks what lies between pairs of quotes */
+inline std::uint64_t PrefixXor(std::uint64_t Bits)
+{
+    Bits ^= Bits << 1;
+    Bits ^= Bits << 2;
+    Bits ^= Bits << 4;
+    Bits ^= Bits << 8;
+    Bits ^= Bits << 16;
+    Bits ^= Bits << 32;
+    return Bits;
+}
+
+/** Returns the characters escaped by a backslash, carrying an odd backslash run at the end over to the next block */
+inline std::uint64_t FindEscaped(std::uint64_t Backslash, bool& bEscaped)
+{
+    constexpr std::uint64_t EvenBits = 0x5555555555555555ULL;
+
+    const std::uint64_t PrevEscaped = bEscaped ? 1 : 0;
+
+    // A first character escaped by the previous block doesn't start a run
+    Backslash &= ~PrevEscaped;
+
+    const std::uint64_t FollowsEscape = (Backslash << 1) | PrevEscaped;
+
+    // Adding runs to their odd starts carries through them; the carry's parity tells which characters are escaped
+    const std::uint64_t OddStarts = Backslash & ~EvenBits & ~FollowsEscape;
+    std::uint64_t EvenStartRuns;
+    bEscaped = __builtin_add_overflow(OddStarts, Backslash, &EvenStartRuns);
+
+    return (EvenBits ^ (EvenStartRuns << 1)) & FollowsEscape;
+}
+
+/** One bit per character of a 64-byte block, as needed for building the structural index */
+struct JsonIndexMasks
+{
+    std::uint64_t Quote;
+    std::uint64_t Backslash;
+    std::uint64_t Whitespace;
+
+    /** Brackets, braces, colons and commas */
+    std::uint64_t Operator;
+};
+
+/** What indexing a block carries over to the next one */
+struct JsonIndexState
+{
+    bool bEscaped = false;
+
+    /** All ones if the previous block ended inside a string */
+    std::uint64_t InString = 0;
+
+    /** Whether the previous block ended with a character a token can start after */
+    std::uint64_t PrevBoundary = 1;
+};
+
+/** Returns the bits of a block's characters that go into the index */
+inline std::uint64_t IndexBlock(const JsonIndexMasks& Masks, JsonIndexState& State)
+{
+    const std::uint64_t Quotes = Masks.Quote & ~FindEscaped(Masks.Backslash, State.bEscaped);
+
+    // Includes opening quotes, excludes closing ones
+    const std::uint64_t InString = PrefixXor(Quotes) ^ State.InString;
+    State.InString = InString >> 63 ? ~std::uint64_t(0) : 0;
+
+    // Anything else outside a string that follows one of these starts a token: a number, a literal or garbage
+    const std::uint64_t Boundary = Masks.Operator | Masks.Whitespace | Masks.Quote;
+    const std::uint64_t TokenStarts = ~Boundary & ~InString & ((Boundary << 1) | State.PrevBoundary);
+    State.PrevBoundary = Boundary >> 63;
+
+    return (Masks.Operator & ~InString) | (Quotes & InString) | TokenStarts;
+}
+
+/** Appends the offsets of the set bits to the index */
+inline std::uint32_t* FlattenBits(std::uint32_t* Out, const std::uint32_t Offset, std::uint64_t Bits)
+{
+    while(Bits != 0){
+        *Out++ = Offset + static_cast<std::uint32_t>(__builtin_ctzll(Bits));
+        Bits &= Bits - 1;
+    }
+
+    return Out;
+}
+
+/**
+ * Runs the indexing over a whole input, classifying each 64-byte block with
+ * Classify. The last partial block is padded with spaces.
+*/
+template<class ClassifyFunc>
+void BuildStructuralIndexWith(const char* Begin, const char* End, std::vector<std::uint32_t>& OutIndex, ClassifyFunc Classify)
+{
+    const std::size_t Length = static_cast<std::size_t>(End - Begin);
+
+    // Room for the worst case of every character being indexed, which only costs address space: pages are touched as they fill
+    OutIndex.clear();
+    OutIndex.reserve(Length);
+
+    JsonIndexState State;
+    JsonIndexMasks Masks;
+    std::uint32_t Offsets[64];
+
+    for(std::size_t Offset{0}; Offset < Length; Offset += 64){
+        std::uint64_t Bits;
+
+        if(Length - Offset >= 64){
+            Classify(Begin + Offset, Masks);
+            Bits = IndexBlock(Masks, State);
+        }else{
+            char Padded[64];
+            std::memset(Padded, ' ', sizeof(Padded));
+            std::memcpy(Padded, Begin + Offset, Length - Offset);
+
+            Classify(Padded, Masks);
+            Bits = IndexBlock(Masks, State) & ((std::uint64_t(1) << (Length - Offset)) - 1);
+        }
+
+        OutIndex.insert(OutIndex.end(), Offsets, FlattenBits(Offsets, static_cast<std::uint32_t>(Offset), Bits));
+    }
+}
+
+void ClassifyBlockScalar(const char* Block, JsonIndexMasks& OutMasks)
+{
+    OutMasks = JsonIndexMasks{0, 0, 0, 0};
+
+    for(int i = 0; i < 64; ++i){
+        const std::uint64_t Bit = std::uint64_t(1) << i;
+
+        switch (Block[i])
+        {
+        case '\"': OutMasks.Quote |= Bit; break;
+        case '\\': OutMasks.Backslash |= Bit; break;
+        case ' ': case '\t': case '\n': case '\r': OutMasks.Whitespace |= Bit; break;
+        case '{': case '}': case '[': case ']': case ':': case ',': OutMasks.Operator |= Bit; break;
+        default: break;
+        }
+    }
+}
+
+void BuildStructuralIndexScalar(const char* Begin, const char* End, std::vector<std::uint32_t>& OutIndex)
+{
+    BuildStructuralIndexWith(Begin, End, OutIndex, &ClassifyBlockScalar);
+}
+
+#if WITH_JSON_SIMD
+
+/** One bit per character of a 64-byte block */
+struct JsonBlockMasks
+{
+    std::uint64_t Quote;
+    std::uint64_t Backslash;
+    std::uint64_t Control;
+    std::uint64_t Open;
+    std::uint64_t Close;
+    std::uint64_t LineFeed;
+};
+
+/** Accounts for the line breaks flagged in the mask of a 64-byte block */
+inline void CountLineBreaks64(const char* Block, std::uint64_t LineBreakMask, JsonSkipState& State)
+{
+    if(LineBreakMask){
+        State.LineBreaks += static_cast<std::uint32_t>(__builtin_popcountll(LineBreakMask));
+        State.LastLineBreak = Block + (63 - __builtin_clzll(LineBreakMask));
+    }
+}
+
+/**
+ * Skips one block given its masks. Returns false, leaving State untouched, if
+ * the caller has to scan it character by character.
+*/
+inline bool SkipBlock(const char* Block, const JsonBlockMasks& Masks, JsonSkipState& State, const char*& OutClose)
+{
+    bool bEscaped = State.bEscaped;
+    const std::uint64_t Quotes = Masks.Quote & ~FindEscaped(Masks.Backslash, bEscaped);
+
+    // Includes opening quotes, excludes closing ones
+    std::uint64_t InString = PrefixXor(Quotes);
+    if(State.bInString){
+        InString = ~InString;
+    }
+
+    if(Masks.Control & InString){
+        return false;
+    }
+
+    const std::uint64_t Open = Masks.Open & ~InString;
+    const std::uint64_t Close = Masks.Close & ~InString;
+    const std::uint64_t LineFeeds = Masks.LineFeed & ~InString;
+    const std::uint32_t Closes = static_cast<std::uint32_t>(__builtin_popcountll(Close));
+
+    // Only a block with more closing brackets than open ones can end the container
+    if(Closes > State.Depth){
+        std::uint32_t Depth = State.Depth;
+
+        for(std::uint64_t Brackets = Open | Close; Brackets != 0; Brackets &= Brackets - 1){
+            const std::uint64_t Bit = Brackets & (~Brackets + 1);
+
+            if(Open & Bit){
+                ++Depth;
+            }else if(Depth > 0){
+                --Depth;
+            }else{
+                CountLineBreaks64(Block, LineFeeds & (Bit - 1), State);
+                State.Depth = 0;
+                State.bInString = false;
+                State.bEscaped = false;
+                State.bClosed = true;
+                OutClose = Block + __builtin_ctzll(Bit);
+                return true;
+            }
+        }
+    }
+
+    CountLineBreaks64(Block, LineFeeds, State);
+    State.Depth = State.Depth + static_cast<std::uint32_t>(__builtin_popcountll(Open)) - Closes;
+    State.bInString = (InString >> 63) != 0;
+    State.bEscaped = bEscaped;
+    return true;
+}
+
+/** Accounts for the line breaks flagged in the mask of a block */
+inline void CountLineBreaks(const char* Block, std::uint32_t LineBreakMask, std::uint32_t& OutLineBreaks, const char*& OutLastLineBreak)
+{
+    if(LineBreakMask){
+        OutLineBreaks += static_cast<std::uint32_t>(__builtin_popcount(LineBreakMask));
+        OutLastLineBreak = Block + (31 - __builtin_clz(LineBreakMask));
+    }
+}
+
+__attribute__((target("sse2")))
+const char* FindStringSpecialSSE2(const char* Begin, const char* End)
+{
+    const __m128i Quote = _mm_set1_epi8('\"');
+    const __m128i Backslash = _mm_set1_epi8('\\');
+    const __m128i ControlMax = _mm_set1_epi8(0x1F);
+
+    while(End - Begin >= 16){
+        const __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Begin));
+        const __m128i Control = _mm_cmpeq_epi8(_mm_max_epu8(Chunk, ControlMax), ControlMax);
+        const __m128i Special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(Chunk, Quote), _mm_cmpeq_epi8(Chunk, Backslash)), Control);
+        const std::uint32_t Mask = static_cast<std::uint32_t>(_mm_movemask_epi8(Special));
+
+        if(Mask){
+            return Begin + __builtin_ctz(Mask);
+        }
+
+        Begin += 16;
+    }
+
+    return FindStringSpecialScalar(Begin, End);
+}
+
+__attribute__((target("sse2")))
+const char* SkipWhitespaceSSE2(const char* Begin, const char* End, std::uint32_t& OutLineBreaks, const char*& OutLastLineBreak)
+{
+    const __m128i Space = _mm_set1_epi8(' ');
+    const __m128i Tab = _mm_set1_epi8('\t');
+    const __m128i LineFeed = _mm_set1_epi8('\n');
+    const __m128i CarriageReturn = _mm_set1_epi8('\r');
+
+    std::uint32_t LineBreaks = 0;
+
+    while(End - Begin >= 16){
+        const __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Begin));
+        const __m128i NewLines = _mm_cmpeq_epi8(Chunk, LineFeed);
+        const __m128i Whitespace = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(Chunk, Space), _mm_cmpeq_epi8(Chunk, Tab)),
+            _mm_or_si128(NewLines, _mm_cmpeq_epi8(Chunk, CarriageReturn)));
+
+        const std::uint32_t Other = ~static_cast<std::uint32_t>(_mm_movemask_epi8(Whitespace)) & 0xFFFF;
+        std::uint32_t LineBreakMask = static_cast<std::uint32_t>(_mm_movemask_epi8(NewLines));
+
+        if(Other){
+            const std::uint32_t Offset = __builtin_ctz(Other);
+            CountLineBreaks(Begin, LineBreakMask & ((1u << Offset) - 1), LineBreaks, OutLastLineBreak);
+            OutLineBreaks = LineBreaks;
+            return Begin + Offset;
+        }
+
+        CountLineBreaks(Begin, LineBreakMask, LineBreaks, OutLastLineBreak);
+        Begin += 16;
+    }
+
+    const char* Result = SkipWhitespaceScalar(Begin, End, OutLineBreaks, OutLastLineBreak);
+    OutLineBreaks += LineBreaks;
+    return Result;
+}
+
+__attribute__((target("sse2")))
+const char* FindStructuralSSE2(const char* Begin, const char* End)
+{
+    const __m128i Quote = _mm_set1_epi8('\"');
+    const __m128i LineFeed = _mm_set1_epi8('\n');
+    const __m128i CurlyOpen = _mm_set1_epi8('{');
+    const __m128i CurlyClose = _mm_set1_epi8('}');
+    const __m128i SquareOpen = _mm_set1_epi8('[');
+    const __m128i SquareClose = _mm_set1_epi8(']');
+
+    while(End - Begin >= 16){
+        const __m128i Chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Begin));
+        const __m128i Brackets = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(Chunk, CurlyOpen), _mm_cmpeq_epi8(Chunk, CurlyClose)),
+            _mm_or_si128(_mm_cmpeq_epi8(Chunk, SquareOpen), _mm_cmpeq_epi8(Chunk, SquareClose)));
+        const __m128i Structural = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(Chunk, Quote), _mm_cmpeq_epi8(Chunk, LineFeed)), Brackets);
+        const std::uint32_t Mask = static_cast<std::uint32_t>(_mm_movemask_epi8(Structural));
+
+        if(Mask){
+            return Begin + __builtin_ctz(Mask);
+        }
+
+        Begin += 16;
+    }
+
+    return FindStructuralScalar(Begin, End);
+}
+
+__attribute__((target("sse2")))
+std::uint64_t MoveMask64SSE2(const __m128i (&Chunks)[4], const __m128i Char)
+{
+    std::uint64_t Mask = 0;
+
+    for(int i = 0; i < 4; ++i){
+        Mask |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(Chunks[i], Char)))) << (16 * i);
+    }
+
+    return Mask;
+}
+
+__attribute__((target("sse2")))
+const char* SkipContainerBlocksSSE2(const char* Begin, const char* End, JsonSkipState& State)
+{
+    const __m128i ControlMax = _mm_set1_epi8(0x1F);
+
+    State.LineBreaks = 0;
+
+    while(End - Begin >= 64){
+        __m128i Chunks[4];
+        JsonBlockMasks Masks;
+        Masks.Control = 0;
+
+        for(int i = 0; i < 4; ++i){
+            Chunks[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Begin + 16 * i));
+            const __m128i Control = _mm_cmpeq_epi8(_mm_max_epu8(Chunks[i], ControlMax), ControlMax);
+            Masks.Control |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(Control))) << (16 * i);
+        }
+
+        Masks.Quote = MoveMask64SSE2(Chunks, _mm_set1_epi8('\"'));
+        Masks.Backslash = MoveMask64SSE2(Chunks, _mm_set1_epi8('\\'));
+        Masks.Open = MoveMask64SSE2(Chunks, _mm_set1_epi8('{')) | MoveMask64SSE2(Chunks, _mm_set1_epi8('['));
+        Masks.Close = MoveMask64SSE2(Chunks, _mm_set1_epi8('}')) | MoveMask64SSE2(Chunks, _mm_set1_epi8(']'));
+        Masks.LineFeed = MoveMask64SSE2(Chunks, _mm_set1_epi8('\n'));
+
+        const char* Close;
+
+        if(!SkipBlock(Begin, Masks, State, Close)){
+            return Begin;
+        }
+
+        if(State.bClosed){
+            return Close;
+        }
+
+        Begin += 64;
+    }
+
+    return Begin;
+}
+
+__attribute__((target("sse2")))
+void ClassifyBlockSSE2(const char* Block, JsonIndexMasks& OutMasks)
+{
+    __m128i Chunks[4];
+
+    for(int i = 0; i < 4; ++i){
+        Chunks[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Block + 16 * i));
+    }
+
+    OutMasks.Quote = MoveMask64SSE2(Chunks, _mm_set1_epi8('\"'));
+    OutMasks.Backslash = MoveMask64SSE2(Chunks, _mm_set1_epi8('\\'));
+    OutMasks.Whitespace = MoveMask64SSE2(Chunks, _mm_set1_epi8(' ')) | MoveMask64SSE2(Chunks, _mm_set1_epi8('\t'))
+        | MoveMask64SSE2(Chunks, _mm_set1_epi8('\n')) | MoveMask64SSE2(Chunks, _mm_set1_epi8('\r'));
+
+    // Setting bit 5 folds '[' and ']' onto '{' and '}'
+    const __m128i Fold = _mm_set1_epi8(0x20);
+    __m128i Folded[4];
+
+    for(int i = 0; i < 4; ++i){
+        Folded[i] = _mm_or_si128(Chunks[i], Fold);
+    }
+
+    OutMasks.Operator = MoveMask64SSE2(Folded, _mm_set1_epi8('{')) | MoveMask64SSE2(Folded, _mm_set1_epi8('}'))
+        | MoveMask64SSE2(Chunks, _mm_set1_epi8(':')) | MoveMask64SSE2(Chunks, _mm_set1_epi8(','));
+}
+
+__attribute__((target("sse2")))
+void BuildStructuralIndexSSE2(const char* Begin, const char* End, std::vector<std::uint32_t>& OutIndex)
+{
+    BuildStructuralIndexWith(Begin, End, OutIndex, &ClassifyBlockSSE2);
+}
+
+__attribute__((target("avx2")))
+const char* FindStringSpecialAVX2(const char* Begin, const char* End)
+{
+    const __m256i Quote = _mm256_set1_epi8('\"');
+    const __m256i Backslash = _mm256_set1_epi8('\\');
+    const __m256i ControlMax = _mm256_set1_epi8(0x1F);
+
+    while(End - Begin >= 32){
+        const __m256i Chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Begin));
+        const __m256i Control = _mm256_cmpeq_epi8(_mm256_max_epu8(Chunk, ControlMax), ControlMax);
+        const __m256i Special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(Chunk, Quote), _mm256_cmpeq_epi8(Chunk, Backslash)), Control);
+        const std::uint32_t Mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(Special));
+
+        if(Mask){
+            return Begin + __builtin_ctz(Mask);
+        }
+
+        Begin += 32;
+    }
+
+    return FindStringSpecialSSE2(Begin, End);
+}
+
+__attribute__((target("avx2")))
+const char* SkipWhitespaceAVX2(const char* Begin, const char* End, std::uint32_t& OutLineBreaks, const char*& OutLastLineBreak)
+{
+    const __m256i Space = _mm256_set1_epi8(' ');
+    const __m256i Tab = _mm256_set1_epi8('\t');
+    const __m256i LineFeed = _mm256_set1_epi8('\n');
+    const __m256i CarriageReturn = _mm256_set1_epi8('\r');
+
+    std::uint32_t LineBreaks = 0;
+
+    while(End - Begin >= 32){
+        const __m256i Chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Begin));
+        const __m256i NewLines = _mm256_cmpeq_epi8(Chunk, LineFeed);
+        const __m256i Whitespace = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(Chunk, Space), _mm256_cmpeq_epi8(Chunk, Tab)),
+            _mm256_or_si256(NewLines, _mm256_cmpeq_epi8(Chunk, CarriageReturn)));
+
+        const std::uint32_t Other = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(Whitespace));
+        const std::uint32_t LineBreakMask = static_cast<std::uint32_t>(_mm256_movemask_epi8(NewLines));
+
+        if(Other){
+            const std::uint32_t Offset = __builtin_ctz(Other);
+            const std::uint32_t Below = Offset == 0 ? 0 : (0xFFFFFFFFu >> (32 - Offset));
+            CountLineBreaks(Begin, LineBreakMask & Below, LineBreaks, OutLastLineBreak);
+            OutLineBreaks = LineBreaks;
+            return Begin + Offset;
+        }
+
+        CountLineBreaks(Begin, LineBreakMask, LineBreaks, OutLastLineBreak);
+        Begin += 32;
+    }
+
+    const char* Result = SkipWhitespaceSSE2(Begin, End, OutLineBreaks, OutLastLineBreak);
+    OutLineBreaks += LineBreaks;
+    return Result;
+}
+
+__attribute__((target("avx2")))
+const char* FindStructuralAVX2(const char* Begin, const char* End)
+{
+    const __m256i Quote = _mm256_set1_epi8('\"');
+    const __m256i LineFeed = _mm256_set1_epi8('\n');
+    const __m256i CurlyOpen = _mm256_set1_epi8('{');
+    const __m256i CurlyClose = _mm256_set1_epi8('}');
+    const __m256i SquareOpen = _mm256_set1_epi8('[');
+    const __m256i SquareClose = _mm256_set1_epi8(']');
+
+    while(End - Begin >= 32){
+        const __m256i Chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Begin));
+        const __m256i Brackets = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(Chunk, CurlyOpen), _mm256_cmpeq_epi8(Chunk, CurlyClose)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(Chunk, SquareOpen), _mm256_cmpeq_epi8(Chunk, SquareClose)));
+        const __m256i Structural = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(Chunk, Quote), _mm256_cmpeq_epi8(Chunk, LineFeed)), Brackets);
+        const std::uint32_t Mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(Structural));
+
+        if(Mask){
+            return Begin + __builtin_ctz(Mask);
+        }
+
+        Begin += 32;
+    }
+
+    return FindStructuralSSE2(Begin, End);
+}
+
+__attribute__((target("avx2")))
+std::uint64_t MoveMask64AVX2(const __m256i Low, const __m256i High, const __m256i Char)
+{
+    const std::uint32_t LowMask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(Low, Char)));
+    const std::uint32_t HighMask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(High, Char)));
+    return static_cast<std::uint64_t>(LowMask) | (static_cast<std::uint64_t>(HighMask) << 32);
+}
+
+__attribute__((target("avx2")))
+const char* SkipContainerBlocksAVX2(const char* Begin, const char* End, JsonSkipState& State)
+{
+    const __m256i ControlMax = _mm256_set1_epi8(0x1F);
+
+    State.LineBreaks = 0;
+
+    while(End - Begin >= 64){
+        const __m256i Low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Begin));
+        const __m256i High = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Begin + 32));
+
+        JsonBlockMasks Masks;
+        Masks.Quote = MoveMask64AVX2(Low, High, _mm256_set1_epi8('\"'));
+        Masks.Backslash = MoveMask64AVX2(Low, High, _mm256_set1_epi8('\\'));
+        Masks.Open = MoveMask64AVX2(Low, High, _mm256_set1_epi8('{')) | MoveMask64AVX2(Low, High, _mm256_set1_epi8('['));
+        Masks.Close = MoveMask64AVX2(Low, High, _mm256_set1_epi8('}')) | MoveMask64AVX2(Low, High, _mm256_set1_epi8(']'));
+        Masks.LineFeed = MoveMask64AVX2(Low, High, _mm256_set1_epi8('\n'));
+        Masks.Control = MoveMask64AVX2(_mm256_max_epu8(Low, ControlMax), _mm256_max_epu8(High, ControlMax), ControlMax);
+
+        const char* Close;
+
+        if(!SkipBlock(Begin, Masks, State, Close)){
+            return Begin;
+        }
+
+        if(State.bClosed){
+            return Close;
+        }
+
+        Begin += 64;
+    }
+
+    return Begin;
+}
+
+__attribute__((target("avx2")))
+void ClassifyBlockAVX2(const char* Block, JsonIndexMasks& OutMasks)
+{
+    const __m256i Low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Block));
+    const __m256i High = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Block + 32));
+
+    OutMasks.Quote = MoveMask64AVX2(Low, High, _mm256_set1_epi8('\"'));
+    OutMasks.Backslash = MoveMask64AVX2(Low, High, _mm256_set1_epi8('\\'));
+    OutMasks.Whitespace = MoveMask64AVX2(Low, High, _mm256_set1_epi8(' ')) | MoveMask64AVX2(Low, High, _mm256_set1_epi8('\t'))
+        | MoveMask64AVX2(Low, High, _mm256_set1_epi8('\n')) | MoveMask64AVX2(Low, High, _mm256_set1_epi8('\r'));
+
+    // Setting bit 5 folds '[' and ']' onto '{' and '}'
+    const __m256i Fold = _mm256_set1_epi8(0x20);
+    const __m256i FoldedLow = _mm256_or_si256(Low, Fold);
+    const __m256i FoldedHigh = _mm256_or_si256(High, Fold);
+
+    OutMasks.Operator = MoveMask64AVX2(FoldedLow, FoldedHigh, _mm256_set1_epi8('{')) | MoveMask64AVX2(FoldedLow, FoldedHigh, _mm256_set1_epi8('}'))
+        | MoveMask64AVX2(Low, High, _mm256_set1_epi8(':')) | MoveMask64AVX2(Low, High, _mm256_set1_epi8(','));
+}
+
+__attribute__((target("avx2")))
+void BuildStructuralIndexAVX2(const char* Begin, const char* End, std::vector<std::uint32_t>& OutIndex)
+{
+    BuildStructuralIndexWith(Begin, End, OutIndex, &ClassifyBlockAVX2);
+}
+
+#endif // WITH_JSON_SIMD
+
+struct JsonScannerDispatch
+{
+    EJsonSimdLevel Level;
+    FindStringSpecialFunc FindStringSpecial;
+    SkipWhitespaceFunc SkipWhitespace;
+    FindStructuralFunc FindStructural;
+    SkipContainerBlocksFunc SkipContainerBlocks;
+    BuildStructuralIndexFunc BuildStructuralIndex;
+};
+
+EJsonSimdLevel DetectSimdLevel()
+{
+#if WITH_JSON_SIMD
+    __builtin_cpu_init();
+
+    if(__builtin_cpu_supports("avx2")){
+        return EJsonSimdLevel::AVX2;
+    }
+
+    if(__builtin_cpu_supports("sse2")){
+        return EJsonSimdLevel::SSE2;
+    }
+#endif // WITH_JSON_SIMD
+
+    return EJsonSimdLevel::Scalar;
+}
+
+#if WITH_JSON_SIMD
+const JsonScannerDispatch AVX2Dispatch = { EJsonSimdLevel::AVX2, &FindStringSpecialAVX2, &SkipWhitespaceAVX2, &FindStructuralAVX2, &SkipContainerBlocksAVX2, &BuildStructuralIndexAVX2 };
+const JsonScannerDispatch SSE2Dispatch = { EJsonSimdLevel::SSE2, &FindStringSpecialSSE2, &SkipWhitespaceSSE2, &FindStructuralSSE2, &SkipContainerBlocksSSE2, &BuildStructuralIndexSSE2 };
+#endif // WITH_JSON_SIMD
+
+const JsonScannerDispatch ScalarDispatch = { EJsonSimdLevel::Scalar, &FindStringSpecialScalar, &SkipWhitespaceScalar, &FindStructuralScalar, &SkipContainerBlocksScalar, &BuildStructuralIndexScalar };
+
+const JsonScannerDispatch* SelectDispatch(EJsonSimdLevel Level)
+{
+    switch (Level)
+    {
+#if WITH_JSON_SIMD
+    case EJsonSimdLevel::AVX2:
+        return &AVX2Dispatch;
+
+    case EJsonSimdLevel::SSE2:
+        return &SSE2Dispatch;
+#endif // WITH_JSON_SIMD
+
+    default:
+        return &ScalarDispatch;
+    }
+}
+
+/**
+ * The table in use. The tables themselves never change, so SetSimdLevel()
+ * only swaps this pointer and readers on other threads need no more than a
+ * relaxed load; a call always sees one complete table.
+*/
+std::atomic<const JsonScannerDispatch*>& GetDispatchSlot()
+{
+    static std::atomic<const JsonScannerDispatch*> Dispatch(SelectDispatch(DetectSimdLevel()));
+    return Dispatch;
+}
+
+inline const JsonScannerDispatch& GetDispatch()
+{
+    return *GetDispatchSlot().load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+const char* JsonScanner::FindStringSpecial(const char* Begin, const char* End)
+{
+    return GetDispatch().FindStringSpecial(Begin, End);
+}
+
+const char* JsonScanner::SkipWhitespace(const char* Begin, const char* End, std::uint32_t& OutLineBreaks, const char*& OutLastLineBreak)
+{
+    return GetDispatch().SkipWhitespace(Begin, End, OutLineBreaks, OutLastLineBreak);
+}
+
+const char* JsonScanner::FindStructural(const char* Begin, const char* End)
+{
+    return GetDispatch().FindStructural(Begin, End);
+}
+
+const char* JsonScanner::SkipContainerBlocks(const char* Begin, const char* End, JsonSkipState& State)
+{
+    return GetDispatch().SkipContainerBlocks(Begin, End, State);
+}
+
+void JsonScanner::BuildStructuralIndex(const char* Begin, const char* End, std::vector<std::uint32_t>& OutIndex)
+{
+    GetDispatch().BuildStructuralIndex(Begin, End, OutIndex);
+}
+
+EJsonSimdLevel JsonScanner::GetSimdLevel()
+{
+    return GetDispatch().Level;
+}
+
+void JsonScanner::SetSimdLevel(EJsonSimdLevel Level)
+{
+    const EJsonSimdLevel Supported = DetectSimdLevel();
+    GetDispatchSlot().store(SelectDispatch(Level < Supported ? Level : Supported), std::memory_order_relaxed);
+}
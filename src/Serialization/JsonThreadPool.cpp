@@ -0,0 +1,62 @@
+#include "Serialization/JsonThreadPool.hpp"
+
+using namespace zexjson;
+
+JsonThreadPool::JsonThreadPool(std::size_t ThreadCount) :
+    bStopping(false)
+{
+    if(ThreadCount == 0){
+        ThreadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+
+    Workers.reserve(ThreadCount);
+
+    for(std::size_t i{0}; i < ThreadCount; ++i){
+        Workers.emplace_back(&JsonThreadPool::RunWorker, this);
+    }
+}
+
+JsonThreadPool::~JsonThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        bStopping = true;
+    }
+
+    TaskAvailable.notify_all();
+
+    for(std::thread& Worker : Workers){
+        Worker.join();
+    }
+}
+
+void JsonThreadPool::Submit(TaskFunction Task)
+{
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        Tasks.push_back(std::move(Task));
+    }
+
+    TaskAvailable.notify_one();
+}
+
+void JsonThreadPool::RunWorker()
+{
+    while(true){
+        TaskFunction Task;
+
+        {
+            std::unique_lock<std::mutex> Lock(Mutex);
+            TaskAvailable.wait(Lock, [this]{ return bStopping || !Tasks.empty(); });
+
+            if(Tasks.empty()){
+                return;
+            }
+
+            Task = std::move(Tasks.front());
+            Tasks.pop_front();
+        }
+
+        Task();
+    }
+}